@@ -110,6 +110,11 @@ public:
 using glProc = void (*)();
 void InitializeExtensions(glProc (*getProcAddress)(const char *));
 
+// Returns whether glDrawElements accepts GL_UNSIGNED_INT indices. Desktop OpenGL always does;
+// OpenGL ES does from version 3, or with GL_OES_element_index_uint, which InitializeExtensions()
+// detects.
+bool isElementIndexUintSupported();
+
 static gl::ExtensionFunction<
     void (GLuint array)>
     BindVertexArray({
@@ -21,6 +21,8 @@ namespace mbgl {
 
 class FileSource;
 class View;
+class WorkerPool;
+class SharedTileCache;
 class MapData;
 class MapContext;
 class SpriteImage;
@@ -38,10 +40,15 @@ class Map : private util::noncopyable {
     friend class View;
 
 public:
+    // Tiles are parsed on the given WorkerPool, which may be shared with other maps. Without
+    // one, the map creates a pool of its own. Likewise, maps given the same SharedTileCache
+    // decode the vector tiles they have in common only once.
     explicit Map(View&, FileSource&,
                  MapMode mapMode = MapMode::Continuous,
                  GLContextMode contextMode = GLContextMode::Unique,
-                 ConstrainMode constrainMode = ConstrainMode::HeightOnly);
+                 ConstrainMode constrainMode = ConstrainMode::HeightOnly,
+                 std::shared_ptr<WorkerPool> workerPool = nullptr,
+                 std::shared_ptr<SharedTileCache> sharedTileCache = nullptr);
     ~Map();
 
     // Pauses the render thread. The render thread will stop running but will not be terminated and will not lose state until resumed.
@@ -85,6 +92,28 @@ public:
 
     // Transition
     void cancelTransitions();
+
+    // Load the tiles along the path of camera animations ahead of time, at a lower priority
+    // than the tiles of the current frame. Disabled by default.
+    void setPrefetchTransitions(bool);
+    bool getPrefetchTransitions() const;
+
+    // Keep the ancestors two and four zoom levels above the tiles in view loaded, so that there
+    // is always a tile to draw when zooming in faster than tiles load. Disabled by default.
+    void setPrefetchParentTiles(bool);
+    bool getPrefetchParentTiles() const;
+
+    // Place the labels of neighbouring tiles around each other, so that labels near tile edges
+    // don't overlap the labels of the adjacent tiles. Disabled by default.
+    void setCrossTilePlacement(bool);
+    bool getCrossTilePlacement() const;
+
+    // Remove vertices of lines and polygons that deviate less than the given number of pixels
+    // from the simplified geometry. Applies to tiles that are parsed afterwards. 0 (the default)
+    // disables simplification.
+    void setGeometrySimplification(float tolerance);
+    float getGeometrySimplification() const;
+
     void setGestureInProgress(bool);
     bool isGestureInProgress() const;
     bool isRotating() const;
@@ -177,7 +206,9 @@ public:
     void removeCustomLayer(const std::string& id);
 
     // Memory
-    void setSourceTileCacheSize(size_t);
+    // Limits the memory, in bytes, used by tiles that went out of view but are kept around in
+    // case they come back. The limit applies to all sources combined.
+    void setTileCacheSize(uint64_t);
     void onLowMemory();
 
     // Debug
@@ -0,0 +1,59 @@
+#ifndef MBGL_MAP_SHARED_TILE_CACHE
+#define MBGL_MAP_SHARED_TILE_CACHE
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+class GeometryTile;
+
+// Decoded vector tiles that are shared between Maps. Every Map decodes the tiles it loads on its
+// own, unless it was given a cache: processes that host many maps with the same sources, such
+// as static renderers, can share one to decode each tile once rather than once per map. A tile
+// stays in the cache as long as at least one map uses it.
+//
+// What is shared is the layer index, the feature tables and the decoded property values of
+// each tile, which take about 0.2 ms to build for a 100 KB tile when a style reads one key of
+// every feature. The buckets built from them are not shared: they depend on the style of each
+// map and own GL buffers of its context.
+class SharedTileCache : private util::noncopyable {
+public:
+    SharedTileCache();
+    ~SharedTileCache();
+
+    // Returns the number of tiles currently in use by at least one map.
+    std::size_t getTileCount() const;
+
+    // Returns the process-wide cache. It is created on first use and destroyed when the last
+    // owner releases it.
+    static std::shared_ptr<SharedTileCache> getShared();
+
+private:
+    friend class VectorTileMonitor;
+
+    // Returns the tile decoded from the given data, which was loaded from the given URL. Tiles
+    // are reused only when their data is identical, so that refreshed tiles replace stale ones.
+    // The lock is only held to look up and store entries, never while comparing or decoding.
+    std::shared_ptr<const GeometryTile> get(const std::string& url, std::shared_ptr<const std::string> data);
+
+    struct Entry {
+        std::weak_ptr<const std::string> data;
+        std::weak_ptr<const GeometryTile> tile;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> tiles;
+
+    // Entries of tiles that are no longer in use are removed once the map has doubled in size.
+    std::size_t sweepSize = 64;
+};
+
+} // namespace mbgl
+
+#endif
@@ -6,6 +6,7 @@
 
 #include <mbgl/util/noncopyable.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -14,6 +15,10 @@ namespace mbgl {
 class FileRequest : private util::noncopyable {
 public:
     virtual ~FileRequest() = default;
+
+    // Requests with lower values are started first when the FileSource has to queue them.
+    // FileSources that don't queue requests ignore the priority.
+    virtual void setPriority(int32_t) {}
 };
 
 class FileSource : private util::noncopyable {
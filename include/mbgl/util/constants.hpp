@@ -22,6 +22,7 @@ extern const double MIN_ZOOM;
 extern const double MAX_ZOOM;
 
 extern const uint64_t DEFAULT_MAX_CACHE_SIZE;
+extern const uint64_t DEFAULT_TILE_CACHE_SIZE;
 
 } // namespace util
 
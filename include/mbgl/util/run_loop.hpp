@@ -8,7 +8,6 @@
 
 #include <functional>
 #include <utility>
-#include <queue>
 #include <mutex>
 #include <atomic>
 
@@ -78,6 +77,18 @@ public:
     template <class Fn, class Cb, class... Args>
     std::unique_ptr<WorkRequest>
     invokeWithCallback(Fn&& fn, Cb&& callback, Args&&... args) {
+        auto task = makeTaskWithCallback(std::move(fn), std::move(callback), std::move(args)...);
+
+        push(task);
+
+        return std::make_unique<WorkRequest>(task);
+    }
+
+    // Create a task that invokes fn(args...) wherever it is run, then invokes callback(results...)
+    // on the current RunLoop. Used by executors other than a RunLoop, e.g. util::ThreadPool.
+    template <class Fn, class Cb, class... Args>
+    static std::shared_ptr<WorkTask>
+    makeTaskWithCallback(Fn&& fn, Cb&& callback, Args&&... args) {
         auto flag = std::make_shared<std::atomic<bool>>();
         *flag = false;
 
@@ -97,14 +108,10 @@ public:
         };
 
         auto tuple = std::make_tuple(std::move(args)..., after);
-        auto task = std::make_shared<Invoker<Fn, decltype(tuple)>>(
+        return std::make_shared<Invoker<Fn, decltype(tuple)>>(
             std::move(fn),
             std::move(tuple),
             flag);
-
-        push(task);
-
-        return std::make_unique<WorkRequest>(task);
     }
 
 private:
@@ -153,27 +160,16 @@ private:
         P params;
     };
 
-    using Queue = std::queue<std::shared_ptr<WorkTask>>;
-
+    // Safe to call from any thread. Wakes up the loop only if the queue was empty, so a burst of
+    // tasks is run in a single batch.
     void push(std::shared_ptr<WorkTask>);
 
-    void withMutex(std::function<void()>&& fn) {
-        std::lock_guard<std::mutex> lock(mutex);
-        fn();
-    }
-
-    void process() {
-        Queue queue_;
-        withMutex([&] { queue_.swap(queue); });
-
-        while (!queue_.empty()) {
-            (*(queue_.front()))();
-            queue_.pop();
-        }
-    }
+    // Runs all tasks that were queued at the time of the call, in the order they were pushed.
+    void process();
 
-    Queue queue;
-    std::mutex mutex;
+    // Lock-free stack of queued tasks, linked through WorkTask::next, most recently pushed
+    // first. process() takes the whole stack at once and reverses it.
+    std::atomic<WorkTask*> queue { nullptr };
 
     class Impl;
     std::unique_ptr<Impl> impl;
@@ -3,6 +3,7 @@
 
 #include <mbgl/util/noncopyable.hpp>
 
+#include <cstdint>
 #include <memory>
 
 namespace mbgl {
@@ -15,6 +16,8 @@ public:
     WorkRequest(Task);
     ~WorkRequest();
 
+    void setPriority(int32_t);
+
 private:
     std::shared_ptr<WorkTask> task;
 };
@@ -3,8 +3,16 @@
 
 #include <mbgl/util/noncopyable.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 namespace mbgl {
 
+namespace util {
+class RunLoop;
+} // namespace util
+
 // A movable type-erasing function wrapper. This allows to store arbitrary invokable
 // things (like std::function<>, or the result of a movable-only std::bind()) in the queue.
 // Source: http://stackoverflow.com/a/29642072/331379
@@ -14,6 +22,19 @@ public:
 
     virtual void operator()() = 0;
     virtual void cancel() = 0;
+
+    // Executors that order their queue, like util::ThreadPool, run tasks with lower values
+    // first. The priority may be changed while the task is queued.
+    void setPriority(int32_t priority_) { priority = priority_; }
+    int32_t getPriority() const { return priority; }
+
+private:
+    std::atomic<int32_t> priority { 0 };
+
+    // Links the task into a RunLoop queue, which keeps it alive until it has been run.
+    friend class util::RunLoop;
+    std::shared_ptr<WorkTask> queued;
+    WorkTask* next = nullptr;
 };
 
 } // namespace mbgl
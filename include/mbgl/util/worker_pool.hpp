@@ -0,0 +1,36 @@
+#ifndef MBGL_UTIL_WORKER_POOL
+#define MBGL_UTIL_WORKER_POOL
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace mbgl {
+
+namespace util {
+class ThreadPool;
+} // namespace util
+
+// The threads that parse tiles for a Map. Unless told otherwise, every Map creates a pool of
+// its own; processes hosting many maps can share one pool between them instead.
+class WorkerPool : private util::noncopyable {
+public:
+    // A thread count of zero creates one thread per hardware thread.
+    explicit WorkerPool(std::size_t threadCount = 0);
+    ~WorkerPool();
+
+    std::size_t getThreadCount() const;
+
+    // Returns the process-wide pool, which is sized to the hardware. It is created on first
+    // use and destroyed when the last owner releases it.
+    static std::shared_ptr<WorkerPool> getShared();
+
+private:
+    friend class Worker;
+    const std::unique_ptr<util::ThreadPool> threads;
+};
+
+} // namespace mbgl
+
+#endif
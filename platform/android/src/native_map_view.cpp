@@ -54,10 +54,9 @@ void log_gl_string(GLenum name, const char *label) {
     }
 }
 
-NativeMapView::NativeMapView(JNIEnv *env, jobject obj_, float pixelRatio_, int availableProcessors_, size_t totalMemory_)
+NativeMapView::NativeMapView(JNIEnv *env, jobject obj_, float pixelRatio_, int /* availableProcessors */, size_t totalMemory_)
     : mbgl::View(*this),
       pixelRatio(pixelRatio_),
-      availableProcessors(availableProcessors_),
       totalMemory(totalMemory_) {
     mbgl::Log::Debug(mbgl::Event::Android, "NativeMapView::NativeMapView");
 
@@ -81,15 +80,8 @@ NativeMapView::NativeMapView(JNIEnv *env, jobject obj_, float pixelRatio_, int a
 
     map = std::make_unique<mbgl::Map>(*this, *fileSource, MapMode::Continuous);
 
-    float zoomFactor   = map->getMaxZoom() - map->getMinZoom() + 1;
-    float cpuFactor    = availableProcessors;
-    float memoryFactor = static_cast<float>(totalMemory) / 1000.0f / 1000.0f / 1000.0f;
-    float sizeFactor   = (static_cast<float>(map->getWidth())  / mbgl::util::tileSize) *
-                         (static_cast<float>(map->getHeight()) / mbgl::util::tileSize);
-
-    size_t cacheSize = zoomFactor * cpuFactor * memoryFactor * sizeFactor * 0.5f;
-
-    map->setSourceTileCacheSize(cacheSize);
+    // Let tiles that went out of view occupy up to 1/32 of the device memory.
+    map->setTileCacheSize(totalMemory / 32);
 
     map->pause();
 }
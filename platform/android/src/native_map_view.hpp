@@ -85,7 +85,6 @@ private:
     int fbHeight = 0;
     const float pixelRatio;
 
-    int availableProcessors = 0;
     size_t totalMemory = 0;
 
     jboolean renderDetach = false;
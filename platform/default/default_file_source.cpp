@@ -113,6 +113,13 @@ public:
         tasks.erase(req);
     }
 
+    void setPriority(FileRequest* req, int32_t priority) {
+        auto it = tasks.find(req);
+        if (it != tasks.end() && it->second->onlineRequest) {
+            it->second->onlineRequest->setPriority(priority);
+        }
+    }
+
     void put(const Resource& resource, const Response& response) {
         offlineDatabase.put(resource, response);
     }
@@ -168,6 +175,10 @@ std::unique_ptr<FileRequest> DefaultFileSource::request(const Resource& resource
             thread.invoke(&DefaultFileSource::Impl::cancel, this);
         }
 
+        void setPriority(int32_t priority) override {
+            thread.invoke(&DefaultFileSource::Impl::setPriority, this, priority);
+        }
+
         util::Thread<DefaultFileSource::Impl>& thread;
         std::unique_ptr<WorkRequest> workRequest;
     };
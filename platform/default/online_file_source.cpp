@@ -12,21 +12,45 @@
 #include <mbgl/util/async_task.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/timer.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/optional.hpp>
 
 #include <algorithm>
 #include <cassert>
-#include <list>
-#include <unordered_set>
+#include <limits>
+#include <map>
 #include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
+class OnlineFileRequestImpl;
+
+// Requests for the same URL and with the same validators share a single HTTP request while it
+// is pending or in flight, and its response is passed on to each of them. This happens when
+// several maps, or a map and an offline download, load the same resource at the same time.
+struct OnlineFileFetch {
+    OnlineFileFetch(const std::string& key_, const Resource& resource_)
+        : key(key_), resource(resource_) {}
+
+    const std::string key;
+    const Resource resource;
+
+    // The requests waiting for the response, in the order in which they joined.
+    std::vector<OnlineFileRequestImpl*> requests;
+
+    // Set while the fetch is in flight.
+    HTTPRequestBase* request = nullptr;
+
+    // Set while the fetch is waiting for room in the active set.
+    optional<std::multimap<int32_t, OnlineFileFetch*>::iterator> pending;
+};
+
 class OnlineFileRequestImpl : public util::noncopyable {
 public:
     using Callback = std::function<void (Response)>;
 
     OnlineFileRequestImpl(FileRequest*, const Resource&, Callback, OnlineFileSource::Impl&);
-    ~OnlineFileRequestImpl();
 
     void networkIsReachableAgain(OnlineFileSource::Impl&);
     void schedule(OnlineFileSource::Impl&, bool forceImmediate = false);
@@ -34,10 +58,13 @@ public:
 
     FileRequest* key;
     Resource resource;
-    HTTPRequestBase* request = nullptr;
+    OnlineFileFetch* fetch = nullptr;
     util::Timer timer;
     Callback callback;
 
+    // Pending requests with lower values are activated first.
+    int32_t priority = 0;
+
     // Counts the number of subsequent failed requests. We're using this value for exponential
     // backoff when retrying requests.
     uint32_t failedRequests = 0;
@@ -53,6 +80,12 @@ public:
 
     ~Impl() {
         NetworkStatus::Unsubscribe(&reachability);
+
+        for (auto& fetch : fetches) {
+            if (fetch.second.request) {
+                fetch.second.request->cancel();
+            }
+        }
     }
 
     void request(FileRequest* key, Resource resource, Callback callback) {
@@ -60,58 +93,101 @@ public:
     }
 
     void cancel(FileRequest* key) {
-        allRequests.erase(key);
-        if (activeRequests.erase(key)) {
-            activatePendingRequest();
-        } else {
-            auto it = pendingRequestsMap.find(key);
-            if (it != pendingRequestsMap.end()) {
-                pendingRequestsList.erase(it->second);
-                pendingRequestsMap.erase(it);
-            }
+        auto it = allRequests.find(key);
+        if (it == allRequests.end()) {
+            return;
+        }
+
+        if (it->second->fetch) {
+            leaveFetch(it->second.get());
+        }
+        allRequests.erase(it);
+    }
+
+    void setPriority(FileRequest* key, int32_t priority) {
+        auto it = allRequests.find(key);
+        if (it == allRequests.end() || it->second->priority == priority) {
+            return;
+        }
+
+        it->second->priority = priority;
+
+        // Move a pending fetch to its new place in the queue.
+        OnlineFileFetch* fetch = it->second->fetch;
+        if (fetch && fetch->pending) {
+            pendingRequestsQueue.erase(*fetch->pending);
+            queueFetch(*fetch);
         }
     }
 
     void activateOrQueueRequest(OnlineFileRequestImpl* impl) {
         assert(allRequests.find(impl->key) != allRequests.end());
-        assert(activeRequests.find(impl->key) == activeRequests.end());
-        assert(!impl->request);
+        assert(!impl->fetch);
+
+        const std::string key = fetchKey(impl->resource);
+
+        auto it = fetches.find(key);
+        if (it != fetches.end()) {
+            // Join the identical fetch, which doesn't take up another slot in the active set.
+            OnlineFileFetch& fetch = it->second;
+            fetch.requests.push_back(impl);
+            impl->fetch = &fetch;
+            if (fetch.pending && impl->priority < (*fetch.pending)->first) {
+                pendingRequestsQueue.erase(*fetch.pending);
+                queueFetch(fetch);
+            }
+            return;
+        }
 
-        if (activeRequests.size() >= HTTPContextBase::maximumConcurrentRequests()) {
-            queueRequest(impl);
+        OnlineFileFetch& fetch = fetches.emplace(std::piecewise_construct,
+            std::forward_as_tuple(key), std::forward_as_tuple(key, impl->resource)).first->second;
+        fetch.requests.push_back(impl);
+        impl->fetch = &fetch;
+
+        if (activeRequests >= HTTPContextBase::maximumConcurrentRequests()) {
+            queueFetch(fetch);
         } else {
-            activateRequest(impl);
+            activateFetch(fetch);
         }
     }
 
-    void queueRequest(OnlineFileRequestImpl* impl) {
-        auto it = pendingRequestsList.insert(pendingRequestsList.end(), impl->key);
-        pendingRequestsMap.emplace(impl->key, std::move(it));
+    void queueFetch(OnlineFileFetch& fetch) {
+        int32_t priority = std::numeric_limits<int32_t>::max();
+        for (const auto& impl : fetch.requests) {
+            priority = std::min(priority, impl->priority);
+        }
+        fetch.pending = pendingRequestsQueue.emplace(priority, &fetch);
     }
 
-    void activateRequest(OnlineFileRequestImpl* impl) {
-        activeRequests.insert(impl->key);
-        impl->request = httpContext->createRequest(impl->resource, [=] (Response response) {
-            impl->request = nullptr;
-            activeRequests.erase(impl->key);
+    void activateFetch(OnlineFileFetch& fetch) {
+        activeRequests++;
+        fetch.request = httpContext->createRequest(fetch.resource, [this, &fetch] (Response response) {
+            const std::string key = fetch.key;
+            std::vector<OnlineFileRequestImpl*> requests = std::move(fetch.requests);
+            for (auto& impl : requests) {
+                impl->fetch = nullptr;
+            }
+
+            fetches.erase(key);
+            activeRequests--;
             activatePendingRequest();
-            impl->completed(*this, response);
+
+            for (auto& impl : requests) {
+                impl->completed(*this, response);
+            }
         });
     }
 
     void activatePendingRequest() {
-        if (pendingRequestsList.empty()) {
+        if (pendingRequestsQueue.empty()) {
             return;
         }
 
-        FileRequest* key = pendingRequestsList.front();
-        pendingRequestsList.pop_front();
+        OnlineFileFetch& fetch = *pendingRequestsQueue.begin()->second;
+        pendingRequestsQueue.erase(pendingRequestsQueue.begin());
+        fetch.pending = {};
 
-        pendingRequestsMap.erase(key);
-
-        auto it = allRequests.find(key);
-        assert(it != allRequests.end());
-        activateRequest(it->second.get());
+        activateFetch(fetch);
     }
 
 private:
@@ -121,6 +197,43 @@ private:
         }
     }
 
+    void leaveFetch(OnlineFileRequestImpl* impl) {
+        OnlineFileFetch& fetch = *impl->fetch;
+        const std::string key = fetch.key;
+        impl->fetch = nullptr;
+
+        fetch.requests.erase(std::find(fetch.requests.begin(), fetch.requests.end(), impl));
+        if (!fetch.requests.empty()) {
+            return;
+        }
+
+        // The last waiting request is gone; drop the fetch.
+        if (fetch.request) {
+            fetch.request->cancel();
+            fetches.erase(key);
+            activeRequests--;
+            activatePendingRequest();
+        } else {
+            if (fetch.pending) {
+                pendingRequestsQueue.erase(*fetch.pending);
+            }
+            fetches.erase(key);
+        }
+    }
+
+    // Conditional requests only share a fetch when they carry the same validators, as the
+    // response depends on them.
+    static std::string fetchKey(const Resource& resource) {
+        std::string key = resource.url;
+        if (resource.priorEtag) {
+            key += "\nETag: " + *resource.priorEtag;
+        }
+        if (resource.priorModified) {
+            key += "\nLast-Modified: " + util::toString(resource.priorModified->time_since_epoch().count());
+        }
+        return key;
+    }
+
     /**
      * The lifetime of a request is:
      *
@@ -129,13 +242,16 @@ private:
      * 3. Active (open network connection)
      * 4. Back to #1
      *
-     * Requests in any state are in `allRequests`. Requests in the pending state are in
-     * `pendingRequests`. Requests in the active state are in `activeRequests`.
+     * Requests in any state are in `allRequests`. Requests that are pending or active wait for
+     * a fetch in `fetches`, which they may share with identical requests. Pending fetches are in
+     * `pendingRequestsQueue`, ordered by the lowest priority among their requests and then by
+     * the time they were queued. `activeRequests` counts the fetches in the active state.
      */
+    using PendingRequests = std::multimap<int32_t, OnlineFileFetch*>;
     std::unordered_map<FileRequest*, std::unique_ptr<OnlineFileRequestImpl>> allRequests;
-    std::list<FileRequest*> pendingRequestsList;
-    std::unordered_map<FileRequest*, std::list<FileRequest*>::iterator> pendingRequestsMap;
-    std::unordered_set<FileRequest*> activeRequests;
+    std::unordered_map<std::string, OnlineFileFetch> fetches;
+    PendingRequests pendingRequestsQueue;
+    std::size_t activeRequests = 0;
 
     const std::unique_ptr<HTTPContextBase> httpContext { HTTPContextBase::createContext() };
     util::AsyncTask reachability { std::bind(&Impl::networkIsReachableAgain, this) };
@@ -188,6 +304,10 @@ std::unique_ptr<FileRequest> OnlineFileSource::request(const Resource& resource,
             thread.invoke(&OnlineFileSource::Impl::cancel, this);
         }
 
+        void setPriority(int32_t priority) override {
+            thread.invoke(&OnlineFileSource::Impl::setPriority, this, priority);
+        }
+
         util::Thread<OnlineFileSource::Impl>& thread;
         std::unique_ptr<WorkRequest> workRequest;
     };
@@ -203,12 +323,6 @@ OnlineFileRequestImpl::OnlineFileRequestImpl(FileRequest* key_, const Resource&
     schedule(impl, !resource.priorExpires);
 }
 
-OnlineFileRequestImpl::~OnlineFileRequestImpl() {
-    if (request) {
-        request->cancel();
-    }
-}
-
 static Duration errorRetryTimeout(Response::Error::Reason failedRequestReason, uint32_t failedRequests) {
     if (failedRequestReason == Response::Error::Reason::Server) {
         // Retry after one second three times, then start exponential backoff.
@@ -232,7 +346,7 @@ static Duration expirationTimeout(optional<SystemTimePoint> expires) {
 }
 
 void OnlineFileRequestImpl::schedule(OnlineFileSource::Impl& impl, bool forceImmediate) {
-    if (request) {
+    if (fetch) {
         // There's already a request in progress; don't start another one.
         return;
     }
@@ -114,6 +114,14 @@ RunLoop::RunLoop(Type type) : impl(std::make_unique<Impl>()) {
 RunLoop::~RunLoop() {
     current.set(nullptr);
 
+    // Release tasks that were pushed but never run.
+    WorkTask* node = queue.exchange(nullptr);
+    while (node) {
+        WorkTask* next = node->next;
+        node->queued.reset();
+        node = next;
+    }
+
     // Close the dummy handle that we have
     // just to keep the main loop alive.
     impl->closeHolder();
@@ -144,8 +152,39 @@ LOOP_HANDLE RunLoop::getLoopHandle() {
 }
 
 void RunLoop::push(std::shared_ptr<WorkTask> task) {
-    withMutex([&] { queue.push(std::move(task)); });
-    impl->async->send();
+    WorkTask* node = task.get();
+    assert(!node->queued);
+    node->queued = std::move(task);
+
+    WorkTask* head = queue.load(std::memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!queue.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+    // Only the first task after the queue was emptied needs to wake up the loop; the others
+    // will be picked up by the same process() call.
+    if (!head) {
+        impl->async->send();
+    }
+}
+
+void RunLoop::process() {
+    WorkTask* node = queue.exchange(nullptr, std::memory_order_acquire);
+
+    // Reverse the stack to run the tasks in the order they were pushed.
+    WorkTask* first = nullptr;
+    while (node) {
+        WorkTask* next = node->next;
+        node->next = first;
+        first = node;
+        node = next;
+    }
+
+    while (first) {
+        std::shared_ptr<WorkTask> task = std::move(first->queued);
+        first = first->next;
+        (*task)();
+    }
 }
 
 void RunLoop::run() {
@@ -684,14 +684,10 @@ public:
 
 - (void)renderSync {
     if (!self.dormant) {
-        CGFloat zoomFactor   = _mbglMap->getMaxZoom() - _mbglMap->getMinZoom() + 1;
-        CGFloat cpuFactor    = (CGFloat)[NSProcessInfo processInfo].processorCount;
-        CGFloat memoryFactor = (CGFloat)[NSProcessInfo processInfo].physicalMemory / 1000 / 1000 / 1000;
-        CGFloat sizeFactor   = ((CGFloat)_mbglMap->getWidth() / mbgl::util::tileSize) * ((CGFloat)_mbglMap->getHeight() / mbgl::util::tileSize);
+        // Let tiles that went out of view occupy up to 1/32 of the physical memory.
+        uint64_t cacheSize = [NSProcessInfo processInfo].physicalMemory / 32;
         
-        NSUInteger cacheSize = zoomFactor * cpuFactor * memoryFactor * sizeFactor * 0.5;
-        
-        _mbglMap->setSourceTileCacheSize(cacheSize);
+        _mbglMap->setTileCacheSize(cacheSize);
         _mbglMap->renderSync();
         
 //        [self updateUserLocationAnnotationView];
@@ -7,6 +7,7 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/thread_context.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <cstdlib>
 #include <cassert>
@@ -36,6 +37,12 @@ public:
         return pos == 0;
     }
 
+    // Returns the number of bytes this buffer occupies in CPU memory, plus the number of
+    // bytes it occupies on the GPU once it was uploaded.
+    std::size_t getByteSize() const {
+        return (array ? length : 0) + (buffer ? pos : 0);
+    }
+
     // Transfers this buffer to the GPU and binds the buffer to the GL context.
     void bind(gl::GLObjectStore& glObjectStore) {
         if (buffer) {
@@ -72,6 +79,14 @@ public:
         }
     }
 
+    // Makes room for at least the given number of elements in addition to the ones that were
+    // already added. Buckets call this with an estimate before adding a feature's geometry.
+    inline void reserve(std::size_t count) {
+        if (length < pos + count * itemSize) {
+            grow(pos + count * itemSize);
+        }
+    }
+
 protected:
     // increase the buffer size by at least /required/ bytes.
     inline void *addElement() {
@@ -79,11 +94,7 @@ protected:
             throw std::runtime_error("Can't add elements after buffer was bound to GPU");
         }
         if (length < pos + itemSize) {
-            while (length < pos + itemSize) length += defaultLength;
-            array = realloc(array, length);
-            if (array == nullptr) {
-                throw std::runtime_error("Buffer reallocation failed");
-            }
+            grow(pos + itemSize);
         }
         pos += itemSize;
         return reinterpret_cast<char *>(array) + (pos - itemSize);
@@ -95,7 +106,7 @@ protected:
             throw std::runtime_error("Buffer was already deleted or doesn't contain elements");
         }
 
-        if (i * itemSize >= pos) {
+        if (i * itemSize >= static_cast<size_t>(pos)) {
             throw std::runtime_error("Can't get element after array bounds");
         } else {
             return reinterpret_cast<char *>(array) + (i * itemSize);
@@ -103,9 +114,62 @@ protected:
     }
 
 public:
-    static const size_t itemSize = item_size;
+    // Returns the size of an element in bytes.
+    size_t getItemSize() const {
+        return itemSize;
+    }
+
+protected:
+    // Buffers whose element size is only known at runtime pass it to the constructor.
+    Buffer(size_t itemSize_ = item_size) : itemSize(itemSize_) {}
+
+    // Converts every value of type From in this buffer to type To, so that elements grow from
+    // itemSize to newItemSize bytes.
+    template <typename From, typename To>
+    void widenElements(size_t newItemSize) {
+        static_assert(sizeof(From) < sizeof(To), "elements can only be widened");
+        if (buffer) {
+            throw std::runtime_error("Can't convert elements after buffer was bound to GPU");
+        }
+        assert(newItemSize * sizeof(From) == itemSize * sizeof(To));
+
+        const size_t count = pos / sizeof(From);
+        if (length < count * sizeof(To)) {
+            grow(count * sizeof(To));
+        }
+
+        // Converting back to front doesn't overwrite values that were not yet read.
+        const From* from = reinterpret_cast<const From*>(array);
+        To* to = reinterpret_cast<To*>(array);
+        for (size_t i = count; i-- > 0;) {
+            to[i] = from[i];
+        }
+
+        pos = count * sizeof(To);
+        itemSize = newItemSize;
+    }
 
 private:
+    // Grows the CPU buffer to hold at least /required/ bytes. The buffer at least doubles in
+    // size every time, so that large buckets are reallocated a few times instead of once per
+    // defaultLength bytes.
+    void grow(size_t required) {
+        size_t newLength = std::max<size_t>(length * 2, defaultLength);
+        while (newLength < required) {
+            newLength *= 2;
+        }
+
+        GLvoid* newArray = realloc(array, newLength);
+        if (newArray == nullptr) {
+            throw std::runtime_error("Buffer reallocation failed");
+        }
+        array = newArray;
+        length = newLength;
+    }
+
+    // Size of an element in bytes.
+    size_t itemSize;
+
     // CPU buffer
     GLvoid *array = nullptr;
 
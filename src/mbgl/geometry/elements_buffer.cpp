@@ -3,14 +3,9 @@
 using namespace mbgl;
 
 void TriangleElementsBuffer::add(element_type a, element_type b, element_type c) {
-    element_type *elements = static_cast<element_type *>(addElement());
-    elements[0] = a;
-    elements[1] = b;
-    elements[2] = c;
+    addIndices({ a, b, c });
 }
 
 void LineElementsBuffer::add(element_type a, element_type b) {
-    element_type *elements = static_cast<element_type *>(addElement());
-    elements[0] = a;
-    elements[1] = b;
+    addIndices({ a, b });
 }
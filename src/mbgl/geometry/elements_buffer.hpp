@@ -6,7 +6,12 @@
 
 #include <mbgl/util/noncopyable.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
 
 namespace mbgl {
 
@@ -23,23 +28,70 @@ struct ElementGroup : public util::noncopyable {
     }
 };
 
-class TriangleElementsBuffer : public Buffer<
-    6, // bytes per triangle (3 * unsigned short == 6 bytes)
+// Element buffers hold 16-bit indices until an index doesn't fit into 16 bits, and are then
+// widened to 32-bit indices. Most buckets have fewer than 65536 vertices and keep the compact
+// format. Widening is only possible where the GL implementation supports 32-bit indices;
+// elsewhere, buckets start a new group before a group exceeds maxGroupVertices().
+template <GLsizei count>
+class ElementsBuffer : public Buffer<
+    count * sizeof(uint16_t),
     GL_ELEMENT_ARRAY_BUFFER
 > {
 public:
-    typedef uint16_t element_type;
+    typedef uint32_t element_type;
 
-    void add(element_type a, element_type b, element_type c);
+    ElementsBuffer(bool uint32Supported_ = gl::isElementIndexUintSupported())
+        : uint32Supported(uint32Supported_) {
+    }
+
+    // Returns the type of the indices, to be passed to glDrawElements.
+    GLenum getElementType() const {
+        return uint32Indices ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    }
+
+    // Returns the number of vertices a single group can reference.
+    GLsizei maxGroupVertices() const {
+        return uint32Supported ? std::numeric_limits<GLsizei>::max() : 65535;
+    }
+
+protected:
+    void addIndices(std::initializer_list<element_type> indices) {
+        if (!uint32Indices && std::max(indices) > std::numeric_limits<uint16_t>::max()) {
+            assert(uint32Supported);
+            this->template widenElements<uint16_t, uint32_t>(count * sizeof(uint32_t));
+            uint32Indices = true;
+        }
+
+        if (uint32Indices) {
+            addIndices<uint32_t>(indices);
+        } else {
+            addIndices<uint16_t>(indices);
+        }
+    }
+
+private:
+    template <typename T>
+    void addIndices(std::initializer_list<element_type> indices) {
+        T *elements = static_cast<T *>(this->addElement());
+        for (const element_type index : indices) {
+            *elements++ = static_cast<T>(index);
+        }
+    }
+
+    const bool uint32Supported;
+    bool uint32Indices = false;
 };
 
+class TriangleElementsBuffer : public ElementsBuffer<3> {
+public:
+    using ElementsBuffer::ElementsBuffer;
 
-class LineElementsBuffer : public Buffer<
-    4, // bytes per triangle (2 * unsigned short == 6 bytes)
-    GL_ELEMENT_ARRAY_BUFFER
-> {
+    void add(element_type a, element_type b, element_type c);
+};
+
+class LineElementsBuffer : public ElementsBuffer<2> {
 public:
-    typedef uint16_t element_type;
+    using ElementsBuffer::ElementsBuffer;
 
     void add(element_type a, element_type b);
 };
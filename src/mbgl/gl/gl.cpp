@@ -2,6 +2,7 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/platform/log.hpp>
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <map>
@@ -17,8 +18,26 @@ std::vector<ExtensionFunctionBase*>& ExtensionFunctionBase::functions() {
 
 static std::once_flag initializeExtensionsOnce;
 
+#ifdef GL_ES_VERSION_2_0
+static std::atomic<bool> elementIndexUint { false };
+#else
+static std::atomic<bool> elementIndexUint { true };
+#endif
+
+bool isElementIndexUintSupported() {
+    return elementIndexUint;
+}
+
 void InitializeExtensions(glProc (*getProcAddress)(const char *)) {
     std::call_once(initializeExtensionsOnce, [getProcAddress] {
+#ifdef GL_ES_VERSION_2_0
+        const char * versionPtr = reinterpret_cast<const char *>(
+            MBGL_CHECK_ERROR(glGetString(GL_VERSION)));
+        if (versionPtr && std::string(versionPtr).compare(0, 12, "OpenGL ES 2.") != 0) {
+            elementIndexUint = true;
+        }
+#endif
+
         const char * extensionsPtr = reinterpret_cast<const char *>(
             MBGL_CHECK_ERROR(glGetString(GL_EXTENSIONS)));
 
@@ -26,6 +45,11 @@ void InitializeExtensions(glProc (*getProcAddress)(const char *)) {
             return;
 
         const std::string extensions = extensionsPtr;
+#ifdef GL_ES_VERSION_2_0
+        if (extensions.find("GL_OES_element_index_uint") != std::string::npos) {
+            elementIndexUint = true;
+        }
+#endif
         for (auto fn : ExtensionFunctionBase::functions()) {
             for (auto probe : fn->probes) {
                 if (extensions.find(probe.first) != std::string::npos) {
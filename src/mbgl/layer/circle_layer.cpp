@@ -1,7 +1,6 @@
 #include <mbgl/layer/circle_layer.hpp>
 #include <mbgl/style/style_bucket_parameters.hpp>
 #include <mbgl/renderer/circle_bucket.hpp>
-#include <mbgl/util/get_geometries.hpp>
 
 namespace mbgl {
 
@@ -46,7 +45,7 @@ std::unique_ptr<Bucket> CircleLayer::createBucket(StyleBucketParameters& paramet
     auto bucket = std::make_unique<CircleBucket>();
 
     parameters.eachFilteredFeature(filter, [&] (const auto& feature) {
-        bucket->addGeometry(getGeometries(feature));
+        bucket->addGeometry(feature);
     });
 
     return std::move(bucket);
@@ -1,7 +1,7 @@
 #include <mbgl/layer/fill_layer.hpp>
 #include <mbgl/style/style_bucket_parameters.hpp>
 #include <mbgl/renderer/fill_bucket.hpp>
-#include <mbgl/util/get_geometries.hpp>
+#include <mbgl/util/simplify.hpp>
 
 namespace mbgl {
 
@@ -56,10 +56,11 @@ bool FillLayer::recalculate(const StyleCalculationParameters& parameters) {
 }
 
 std::unique_ptr<Bucket> FillLayer::createBucket(StyleBucketParameters& parameters) const {
-    auto bucket = std::make_unique<FillBucket>();
+    auto bucket = std::make_unique<FillBucket>(&parameters.cancellation,
+        util::Simplifier::tolerance(parameters.simplificationTolerance, parameters.tileID.overscaling));
 
     parameters.eachFilteredFeature(filter, [&] (const auto& feature) {
-        bucket->addGeometry(getGeometries(feature));
+        bucket->addGeometry(feature);
     });
 
     return std::move(bucket);
@@ -2,7 +2,7 @@
 #include <mbgl/style/style_bucket_parameters.hpp>
 #include <mbgl/renderer/line_bucket.hpp>
 #include <mbgl/map/tile_id.hpp>
-#include <mbgl/util/get_geometries.hpp>
+#include <mbgl/util/simplify.hpp>
 
 namespace mbgl {
 
@@ -69,7 +69,8 @@ bool LineLayer::recalculate(const StyleCalculationParameters& parameters) {
 }
 
 std::unique_ptr<Bucket> LineLayer::createBucket(StyleBucketParameters& parameters) const {
-    auto bucket = std::make_unique<LineBucket>(parameters.tileID.overscaling);
+    auto bucket = std::make_unique<LineBucket>(parameters.tileID.overscaling,
+        util::Simplifier::tolerance(parameters.simplificationTolerance, parameters.tileID.overscaling));
 
     bucket->layout = layout;
 
@@ -80,7 +81,7 @@ std::unique_ptr<Bucket> LineLayer::createBucket(StyleBucketParameters& parameter
     bucket->layout.roundLimit.calculate(p);
 
     parameters.eachFilteredFeature(filter, [&] (const auto& feature) {
-        bucket->addGeometry(getGeometries(feature));
+        bucket->addGeometry(feature);
     });
 
     return std::move(bucket);
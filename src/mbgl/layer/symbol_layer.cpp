@@ -163,7 +163,7 @@ std::unique_ptr<Bucket> SymbolLayer::createBucket(StyleBucketParameters& paramet
     bucket->layout.icon.size.calculate(StyleCalculationParameters(p.z + 1));
     bucket->layout.text.size.calculate(StyleCalculationParameters(p.z + 1));
 
-    bucket->parseFeatures(parameters.layer, filter);
+    bucket->parseFeatures(parameters.layer, filter, parameters.cancellation);
 
     if (bucket->needsDependencies(parameters.glyphStore, parameters.spriteStore)) {
         parameters.partialParse = true;
@@ -177,7 +177,8 @@ std::unique_ptr<Bucket> SymbolLayer::createBucket(StyleBucketParameters& paramet
         bucket->addFeatures(parameters.tileUID,
                             *spriteAtlas,
                             parameters.glyphAtlas,
-                            parameters.glyphStore);
+                            parameters.glyphStore,
+                            parameters.cancellation);
     }
 
     return std::move(bucket);
@@ -13,15 +13,19 @@
 #include <mbgl/util/projection.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/worker_pool.hpp>
 
 namespace mbgl {
 
-Map::Map(View& view_, FileSource& fileSource, MapMode mapMode, GLContextMode contextMode, ConstrainMode constrainMode)
+Map::Map(View& view_, FileSource& fileSource, MapMode mapMode, GLContextMode contextMode, ConstrainMode constrainMode,
+         std::shared_ptr<WorkerPool> workerPool, std::shared_ptr<SharedTileCache> sharedTileCache)
     : view(view_),
       transform(std::make_unique<Transform>(view, constrainMode)),
       context(std::make_unique<util::Thread<MapContext>>(
         util::ThreadContext{"Map", util::ThreadType::Map, util::ThreadPriority::Regular},
-        view, fileSource, mapMode, contextMode, view.getPixelRatio())),
+        view, fileSource, mapMode, contextMode, view.getPixelRatio(),
+        workerPool ? workerPool : std::make_shared<WorkerPool>(4),
+        sharedTileCache)),
       data(&context->invokeSync<MapData&>(&MapContext::getData))
 {
     view.initialize(this);
@@ -95,7 +99,7 @@ void Map::update(Update flags) {
     if (flags & Update::Dimensions) {
         transform->resize(view.getSize());
     }
-    context->invoke(&MapContext::triggerUpdate, transform->getState(), flags);
+    context->invoke(&MapContext::triggerUpdate, transform->getState(), flags, transform->getTransitionPath());
 }
 
 #pragma mark - Style
@@ -125,6 +129,40 @@ void Map::cancelTransitions() {
     update(Update::Repaint);
 }
 
+void Map::setPrefetchTransitions(bool enabled) {
+    transform->setPrefetchTransitions(enabled);
+}
+
+bool Map::getPrefetchTransitions() const {
+    return transform->getPrefetchTransitions();
+}
+
+void Map::setPrefetchParentTiles(bool enabled) {
+    data->setPrefetchParentTiles(enabled);
+    update(Update::Repaint);
+}
+
+bool Map::getPrefetchParentTiles() const {
+    return data->getPrefetchParentTiles();
+}
+
+void Map::setCrossTilePlacement(bool enabled) {
+    data->setCrossTilePlacement(enabled);
+    update(Update::Repaint);
+}
+
+bool Map::getCrossTilePlacement() const {
+    return data->getCrossTilePlacement();
+}
+
+void Map::setGeometrySimplification(float tolerance) {
+    data->setGeometrySimplification(tolerance);
+}
+
+float Map::getGeometrySimplification() const {
+    return data->getGeometrySimplification();
+}
+
 void Map::setGestureInProgress(bool inProgress) {
     transform->setGestureInProgress(inProgress);
     update(Update::Repaint);
@@ -559,8 +597,8 @@ Duration Map::getDefaultTransitionDelay() const {
     return data->getDefaultTransitionDelay();
 }
 
-void Map::setSourceTileCacheSize(size_t size) {
-    context->invoke(&MapContext::setSourceTileCacheSize, size);
+void Map::setTileCacheSize(uint64_t size) {
+    context->invoke(&MapContext::setTileCacheSize, size);
 }
 
 void Map::onLowMemory() {
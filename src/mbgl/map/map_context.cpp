@@ -28,10 +28,11 @@
 
 namespace mbgl {
 
-MapContext::MapContext(View& view_, FileSource& fileSource_, MapMode mode_, GLContextMode contextMode_, const float pixelRatio_)
+MapContext::MapContext(View& view_, FileSource& fileSource_, MapMode mode_, GLContextMode contextMode_, const float pixelRatio_,
+                       std::shared_ptr<WorkerPool> workerPool_, std::shared_ptr<SharedTileCache> sharedTileCache_)
     : view(view_),
       fileSource(fileSource_),
-      dataPtr(std::make_unique<MapData>(mode_, contextMode_, pixelRatio_)),
+      dataPtr(std::make_unique<MapData>(mode_, contextMode_, pixelRatio_, std::move(workerPool_), std::move(sharedTileCache_))),
       data(*dataPtr),
       asyncUpdate([this] { update(); }),
       asyncInvalidate([&view_] { view_.invalidate(); }),
@@ -78,8 +79,10 @@ void MapContext::pause() {
     asyncInvalidate.send();
 }
 
-void MapContext::triggerUpdate(const TransformState& state, const Update flags) {
+void MapContext::triggerUpdate(const TransformState& state, const Update flags,
+                               std::shared_ptr<const TransformPath> path) {
     transformState = state;
+    transitionPath = std::move(path);
     updateFlags |= flags;
 
     asyncUpdate.send();
@@ -125,6 +128,17 @@ void MapContext::setStyleJSON(const std::string& json, const std::string& base)
     }
 
     styleURL.clear();
+
+    // Restyling that only changes paint properties, like switching between themes that share
+    // their layout, keeps the tiles and their buckets.
+    if (style && style->setPaintJSON(json, styleJSON)) {
+        styleRequest = nullptr;
+        styleJSON = json;
+        updateFlags |= Update::Classes | Update::Zoom;
+        asyncUpdate.send();
+        return;
+    }
+
     styleJSON.clear();
 
     style = std::make_unique<Style>(data, fileSource);
@@ -137,6 +151,7 @@ void MapContext::loadStyleJSON(const std::string& json, const std::string& base)
 
     style->setJSON(json, base);
     style->setObserver(this);
+    style->setTileCacheSize(tileCacheSize);
     styleJSON = json;
 
     // force style cascade, causing all pending transitions to complete.
@@ -176,7 +191,7 @@ void MapContext::update() {
         style->recalculate(transformState.getZoom());
     }
 
-    style->update(transformState, *texturePool);
+    style->update(transformState, transitionPath, *texturePool);
 
     if (data.mode == MapMode::Continuous) {
         asyncInvalidate.send();
@@ -288,12 +303,12 @@ void MapContext::removeLayer(const std::string& id) {
     asyncUpdate.send();
 }
 
-void MapContext::setSourceTileCacheSize(size_t size) {
+void MapContext::setTileCacheSize(uint64_t size) {
     assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
-    if (size != sourceCacheSize) {
-        sourceCacheSize = size;
+    if (size != tileCacheSize) {
+        tileCacheSize = size;
         if (!style) return;
-        style->setSourceTileCacheSize(size);
+        style->setTileCacheSize(size);
         asyncInvalidate.send();
     }
 }
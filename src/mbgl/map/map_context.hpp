@@ -8,6 +8,7 @@
 #include <mbgl/map/map_data.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/util/async_task.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/ptr.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/gl/gl_object_store.hpp>
@@ -30,14 +31,16 @@ struct FrameData {
 
 class MapContext : public Style::Observer {
 public:
-    MapContext(View&, FileSource&, MapMode, GLContextMode, const float pixelRatio);
+    MapContext(View&, FileSource&, MapMode, GLContextMode, const float pixelRatio,
+               std::shared_ptr<WorkerPool>, std::shared_ptr<SharedTileCache> = nullptr);
     ~MapContext();
 
     MapData& getData() { return data; }
 
     void pause();
 
-    void triggerUpdate(const TransformState&, Update = Update::Nothing);
+    void triggerUpdate(const TransformState&, Update = Update::Nothing,
+                       std::shared_ptr<const TransformPath> = nullptr);
     void renderStill(const TransformState&, const FrameData&, Map::StillImageCallback callback);
 
     // Triggers a synchronous render. Returns true if style has been fully loaded.
@@ -61,7 +64,7 @@ public:
                   const optional<std::string> before);
     void removeLayer(const std::string& id);
 
-    void setSourceTileCacheSize(size_t size);
+    void setTileCacheSize(uint64_t size);
     void onLowMemory();
 
     void cleanup();
@@ -98,8 +101,9 @@ private:
     std::unique_ptr<FileRequest> styleRequest;
 
     Map::StillImageCallback callback;
-    size_t sourceCacheSize;
+    uint64_t tileCacheSize = util::DEFAULT_TILE_CACHE_SIZE;
     TransformState transformState;
+    std::shared_ptr<const TransformPath> transitionPath;
     FrameData frameData;
 };
 
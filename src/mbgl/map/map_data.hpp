@@ -13,6 +13,8 @@
 #include <mbgl/map/mode.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/util/exclusive.hpp>
+#include <mbgl/util/worker_pool.hpp>
+#include <mbgl/map/shared_tile_cache.hpp>
 
 namespace mbgl {
 
@@ -20,16 +22,21 @@ class MapData {
     using Lock = std::lock_guard<std::mutex>;
 
 public:
-    inline MapData(MapMode mode_, GLContextMode contextMode_, const float pixelRatio_)
+    inline MapData(MapMode mode_, GLContextMode contextMode_, const float pixelRatio_,
+                   std::shared_ptr<WorkerPool> workerPool_,
+                   std::shared_ptr<SharedTileCache> sharedTileCache_ = nullptr)
         : mode(mode_)
         , contextMode(contextMode_)
         , pixelRatio(pixelRatio_)
+        , workerPool(std::move(workerPool_))
+        , sharedTileCache(std::move(sharedTileCache_))
         , annotationManager(pixelRatio)
         , animationTime(Duration::zero())
         , defaultFadeDuration(mode_ == MapMode::Continuous ? Milliseconds(300) : Duration::zero())
         , defaultTransitionDuration(Duration::zero())
         , defaultTransitionDelay(Duration::zero()) {
         assert(pixelRatio > 0);
+        assert(workerPool);
     }
 
     // Adds the class if it's not yet set. Returns true when it added the class, and false when it
@@ -71,6 +78,30 @@ public:
         debugOptions = debugOptions_;
     }
 
+    inline bool getPrefetchParentTiles() const {
+        return prefetchParentTiles;
+    }
+
+    inline void setPrefetchParentTiles(bool enabled) {
+        prefetchParentTiles = enabled;
+    }
+
+    inline bool getCrossTilePlacement() const {
+        return crossTilePlacement;
+    }
+
+    inline void setCrossTilePlacement(bool enabled) {
+        crossTilePlacement = enabled;
+    }
+
+    inline float getGeometrySimplification() const {
+        return geometrySimplification;
+    }
+
+    inline void setGeometrySimplification(float tolerance) {
+        geometrySimplification = tolerance;
+    }
+
     inline TimePoint getAnimationTime() const {
         // We're casting the TimePoint to and from a Duration because libstdc++
         // has a bug that doesn't allow TimePoints to be atomic.
@@ -130,6 +161,9 @@ public:
     const MapMode mode;
     const GLContextMode contextMode;
     const float pixelRatio;
+    const std::shared_ptr<WorkerPool> workerPool;
+    // Optional, see Map::Map().
+    const std::shared_ptr<SharedTileCache> sharedTileCache;
 
 private:
     mutable std::mutex annotationManagerMutex;
@@ -139,6 +173,9 @@ private:
 
     std::vector<std::string> classes;
     std::atomic<MapDebugOptions> debugOptions { MapDebugOptions::NoDebug };
+    std::atomic<bool> prefetchParentTiles { false };
+    std::atomic<bool> crossTilePlacement { false };
+    std::atomic<float> geometrySimplification { 0 };
     std::atomic<Duration> animationTime;
     std::atomic<Duration> defaultFadeDuration;
     std::atomic<Duration> defaultTransitionDuration;
@@ -0,0 +1,74 @@
+#include <mbgl/map/shared_tile_cache.hpp>
+#include <mbgl/tile/vector_tile.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+SharedTileCache::SharedTileCache() = default;
+
+SharedTileCache::~SharedTileCache() = default;
+
+std::size_t SharedTileCache::getTileCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::count_if(tiles.begin(), tiles.end(), [] (const auto& pair) {
+        return !pair.second.tile.expired();
+    });
+}
+
+std::shared_ptr<SharedTileCache> SharedTileCache::getShared() {
+    static std::mutex mutex;
+    static std::weak_ptr<SharedTileCache> shared;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto cache = shared.lock();
+    if (!cache) {
+        cache = std::make_shared<SharedTileCache>();
+        shared = cache;
+    }
+    return cache;
+}
+
+std::shared_ptr<const GeometryTile> SharedTileCache::get(const std::string& url, std::shared_ptr<const std::string> data) {
+    std::shared_ptr<const std::string> cachedData;
+    std::shared_ptr<const GeometryTile> tile;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = tiles.find(url);
+        if (it != tiles.end()) {
+            cachedData = it->second.data.lock();
+            tile = it->second.tile.lock();
+        }
+    }
+
+    // Maps that share a FileSource usually receive the same data object, but maps that load the
+    // tile separately get their own copy of the same bytes. Comparing them takes about 2µs for a
+    // 100 KB tile, and is done without holding the lock.
+    if (tile && cachedData && (cachedData == data || *cachedData == *data)) {
+        return tile;
+    }
+
+    // Decoding is deferred until the tile's layers are requested, on a worker thread.
+    tile = std::make_shared<const VectorTile>(data);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Entry& entry = tiles[url];
+    entry.data = data;
+    entry.tile = tile;
+
+    if (tiles.size() >= sweepSize) {
+        for (auto it = tiles.begin(); it != tiles.end();) {
+            if (it->second.tile.expired()) {
+                it = tiles.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        sweepSize = std::max(tiles.size() * 2, sweepSize);
+    }
+
+    return tile;
+}
+
+} // namespace mbgl
@@ -36,6 +36,9 @@ static double _normalizeAngle(double angle, double anchorAngle)
     return angle;
 }
 
+// Number of camera states sampled along an animated transition for prefetching.
+static const std::size_t transitionPathSamples = 8;
+
 inline bool _validPoint(const PrecisionPoint& point) {
     return !std::isnan(point.x) && !std::isnan(point.y);
 }
@@ -584,6 +587,24 @@ void Transform::startTransition(const CameraOptions& camera,
     transitionStart = Clock::now();
     transitionDuration = duration;
 
+    if (isAnimated && prefetchTransitions) {
+        // Evaluate the frames at evenly spaced times ahead of time, then go back to the
+        // starting point.
+        util::UnitBezier ease = animation.easing ? *animation.easing : util::UnitBezier(0, 0, 0.25, 1);
+        const TransformState startState = state;
+        auto path = std::make_shared<TransformPath>();
+        for (std::size_t i = 1; i <= transitionPathSamples; ++i) {
+            const double t = double(i) / transitionPathSamples;
+            frame(i == transitionPathSamples ? 1.0 : ease.solve(t, 0.001));
+            if (_validPoint(anchor)) {
+                state.moveLatLng(anchorLatLng, anchor);
+            }
+            path->push_back(state);
+            state = startState;
+        }
+        transitionPath = std::move(path);
+    }
+
     transitionFrameFn = [isAnimated, animation, frame, anchor, anchorLatLng, this](const TimePoint now) {
         float t = isAnimated ? (std::chrono::duration<float>(now - transitionStart) / transitionDuration) : 1.0;
         Update result;
@@ -616,6 +637,7 @@ void Transform::startTransition(const CameraOptions& camera,
     };
 
     transitionFinishFn = [isAnimated, animation, this] {
+        transitionPath = nullptr;
         state.panning = false;
         state.scaling = false;
         state.rotating = false;
@@ -643,6 +665,8 @@ void Transform::cancelTransitions() {
         transitionFinishFn();
     }
 
+    transitionPath = nullptr;
+
     transitionFrameFn = nullptr;
     transitionFinishFn = nullptr;
 }
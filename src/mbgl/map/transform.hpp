@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <cmath>
 #include <functional>
+#include <memory>
 
 namespace mbgl {
 
@@ -125,6 +126,14 @@ public:
     Update updateTransitions(const TimePoint& now);
     void cancelTransitions();
 
+    /** Enables sampling the camera path of animated transitions, so that the
+        tiles along the path can be loaded ahead of time. */
+    void setPrefetchTransitions(bool enabled) { prefetchTransitions = enabled; }
+    bool getPrefetchTransitions() const { return prefetchTransitions; }
+    /** Returns the camera states along the running transition, or null if no
+        transition is running or prefetching is disabled. */
+    std::shared_ptr<const TransformPath> getTransitionPath() const { return transitionPath; }
+
     // Gesture
     void setGestureInProgress(bool);
     bool isGestureInProgress() const { return state.isGestureInProgress(); }
@@ -155,6 +164,9 @@ private:
     Duration transitionDuration;
     std::function<Update(const TimePoint)> transitionFrameFn;
     std::function<void()> transitionFinishFn;
+
+    bool prefetchTransitions = false;
+    std::shared_ptr<const TransformPath> transitionPath;
 };
 
 } // namespace mbgl
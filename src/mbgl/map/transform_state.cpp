@@ -210,6 +210,13 @@ bool TransformState::isGestureInProgress() const {
     return gestureInProgress;
 }
 
+bool TransformState::hasSameView(const TransformState& other) const {
+    return x == other.x && y == other.y && scale == other.scale &&
+           angle == other.angle && pitch == other.pitch && altitude == other.altitude &&
+           width == other.width && height == other.height &&
+           orientation == other.orientation;
+}
+
 
 #pragma mark - Projection
 
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <array>
 #include <limits>
+#include <vector>
 
 namespace mbgl {
 
@@ -62,6 +63,10 @@ public:
     bool isPanning() const;
     bool isGestureInProgress() const;
 
+    // Returns whether both states show exactly the same part of the map: the same position,
+    // zoom, rotation, pitch, size and north orientation. Animation and gesture flags are ignored.
+    bool hasSameView(const TransformState&) const;
+
     // Conversion and projection
     PrecisionPoint latLngToPoint(const LatLng&) const;
     LatLng pointToLatLng(const PrecisionPoint&) const;
@@ -123,6 +128,9 @@ private:
     double Cc = (scale * util::tileSize) / util::M2PI;
 };
 
+// Camera states sampled along a running animation, in the order in which they will be reached.
+using TransformPath = std::vector<TransformState>;
+
 } // namespace mbgl
 
 #endif // MBGL_MAP_TRANSFORM_STATE
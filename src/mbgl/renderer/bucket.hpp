@@ -7,6 +7,7 @@
 #include <mbgl/util/mat4.hpp>
 
 #include <atomic>
+#include <cstddef>
 
 #define BUFFER_OFFSET_0  ((GLbyte*)nullptr)
 #define BUFFER_OFFSET(i) ((BUFFER_OFFSET_0) + (i))
@@ -17,6 +18,7 @@ class Painter;
 class StyleLayer;
 class TileID;
 class CollisionTile;
+class TileCancellation;
 
 namespace gl {
 class GLObjectStore;
@@ -38,11 +40,15 @@ public:
 
     virtual bool hasData() const = 0;
 
+    // Returns the number of bytes held by this bucket's buffers and textures, both in CPU
+    // memory and on the GPU.
+    virtual std::size_t getByteSize() const = 0;
+
     inline bool needsUpload() const {
         return !uploaded;
     }
 
-    virtual void placeFeatures(CollisionTile&) {}
+    virtual void placeFeatures(CollisionTile&, const TileCancellation&) {}
     virtual void swapRenderData() {}
 
 protected:
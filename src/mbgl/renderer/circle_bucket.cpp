@@ -4,6 +4,7 @@
 #include <mbgl/shader/circle_shader.hpp>
 #include <mbgl/layer/circle_layer.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/get_geometries.hpp>
 
 using namespace mbgl;
 
@@ -31,48 +32,72 @@ bool CircleBucket::hasData() const {
     return !triangleGroups_.empty();
 }
 
+std::size_t CircleBucket::getByteSize() const {
+    return vertexBuffer_.getByteSize() + elementsBuffer_.getByteSize();
+}
+
 void CircleBucket::addGeometry(const GeometryCollection& geometryCollection) {
     for (auto& circle : geometryCollection) {
-        for(auto & geometry : circle) {
-            auto x = geometry.x;
-            auto y = geometry.y;
-
-            // Do not include points that are outside the tile boundaries.
-            if (x < 0 || x >= util::EXTENT || y < 0 || y >= util::EXTENT) continue;
-
-            // this geometry will be of the Point type, and we'll derive
-            // two triangles from it.
-            //
-            // ┌─────────┐
-            // │ 4     3 │
-            // │         │
-            // │ 1     2 │
-            // └─────────┘
-            //
-            vertexBuffer_.add(x, y, -1, -1); // 1
-            vertexBuffer_.add(x, y, 1, -1); // 2
-            vertexBuffer_.add(x, y, 1, 1); // 3
-            vertexBuffer_.add(x, y, -1, 1); // 4
-
-            if (!triangleGroups_.size() || (triangleGroups_.back()->vertex_length + 4 > 65535)) {
-                // Move to a new group because the old one can't hold the geometry.
-                triangleGroups_.emplace_back(std::make_unique<TriangleGroup>());
-            }
-
-            TriangleGroup& group = *triangleGroups_.back();
-            auto index = group.vertex_length;
-
-            // 1, 2, 3
-            // 1, 4, 3
-            elementsBuffer_.add(index, index + 1, index + 2);
-            elementsBuffer_.add(index, index + 3, index + 2);
-
-            group.vertex_length += 4;
-            group.elements_length += 2;
+        for (auto& point : circle) {
+            addCircle(point);
         }
     }
 }
 
+void CircleBucket::addGeometry(const GeometryTileFeature& feature) {
+    class Visitor : public GeometryVisitor {
+    public:
+        Visitor(CircleBucket& bucket_) : bucket(bucket_) {}
+
+        void beginLine() override {}
+        void addPoint(const Coordinate& point) override { bucket.addCircle(point); }
+        void endLine() override {}
+
+    private:
+        CircleBucket& bucket;
+    } visitor(*this);
+
+    visitGeometries(feature, visitor);
+}
+
+void CircleBucket::addCircle(const Coordinate& point) {
+    auto x = point.x;
+    auto y = point.y;
+
+    // Do not include points that are outside the tile boundaries.
+    if (x < 0 || x >= util::EXTENT || y < 0 || y >= util::EXTENT) return;
+
+    // this geometry will be of the Point type, and we'll derive
+    // two triangles from it.
+    //
+    // ┌─────────┐
+    // │ 4     3 │
+    // │         │
+    // │ 1     2 │
+    // └─────────┘
+    //
+    vertexBuffer_.add(x, y, -1, -1); // 1
+    vertexBuffer_.add(x, y, 1, -1); // 2
+    vertexBuffer_.add(x, y, 1, 1); // 3
+    vertexBuffer_.add(x, y, -1, 1); // 4
+
+    if (!triangleGroups_.size() || (triangleGroups_.back()->vertex_length + 4 > elementsBuffer_.maxGroupVertices())) {
+        // Move to a new group because the old one can't hold the geometry.
+        triangleGroups_.emplace_back(std::make_unique<TriangleGroup>());
+    }
+
+    TriangleGroup& group = *triangleGroups_.back();
+    auto index = group.vertex_length;
+
+    // 1, 2, 3
+    // 1, 4, 3
+    elementsBuffer_.add(index, index + 1, index + 2);
+    elementsBuffer_.add(index, index + 3, index + 2);
+
+    group.vertex_length += 4;
+    group.elements_length += 2;
+}
+
 void CircleBucket::drawCircles(CircleShader& shader, gl::GLObjectStore& glObjectStore) {
     GLbyte* vertexIndex = BUFFER_OFFSET(0);
     GLbyte* elementsIndex = BUFFER_OFFSET(0);
@@ -84,9 +109,9 @@ void CircleBucket::drawCircles(CircleShader& shader, gl::GLObjectStore& glObject
 
         group->array[0].bind(shader, vertexBuffer_, elementsBuffer_, vertexIndex, glObjectStore);
 
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elementsIndex));
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, elementsBuffer_.getElementType(), elementsIndex));
 
-        vertexIndex += group->vertex_length * vertexBuffer_.itemSize;
-        elementsIndex += group->elements_length * elementsBuffer_.itemSize;
+        vertexIndex += group->vertex_length * vertexBuffer_.getItemSize();
+        elementsIndex += group->elements_length * elementsBuffer_.getItemSize();
     }
 }
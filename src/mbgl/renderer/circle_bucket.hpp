@@ -24,11 +24,15 @@ public:
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
 
     bool hasData() const override;
+    std::size_t getByteSize() const override;
     void addGeometry(const GeometryCollection&);
+    void addGeometry(const GeometryTileFeature&);
 
     void drawCircles(CircleShader&, gl::GLObjectStore&);
 
 private:
+    void addCircle(const Coordinate&);
+
     CircleVertexBuffer vertexBuffer_;
     TriangleElementsBuffer elementsBuffer_;
 
@@ -8,6 +8,8 @@
 #include <mbgl/shader/outline_shader.hpp>
 #include <mbgl/gl/gl.hpp>
 #include <mbgl/platform/log.hpp>
+#include <mbgl/util/get_geometries.hpp>
+#include <mbgl/tile/tile_cancellation.hpp>
 
 #include <cassert>
 
@@ -27,8 +29,9 @@ void FillBucket::free(void *, void *ptr) {
     ::free(ptr);
 }
 
-FillBucket::FillBucket()
-    : allocator(new TESSalloc{
+FillBucket::FillBucket(const TileCancellation* cancellation_, double simplificationTolerance)
+    : cancellation(cancellation_),
+      allocator(new TESSalloc{
           &alloc,
           &realloc,
           &free,
@@ -40,7 +43,8 @@ FillBucket::FillBucket()
           8,       // regionBucketSize
           128,     // extraVertices allocated for the priority queue.
       }),
-      tesselator(tessNewTess(allocator)) {
+      tesselator(tessNewTess(allocator)),
+      simplifier(simplificationTolerance) {
     assert(tesselator);
 }
 
@@ -54,26 +58,209 @@ FillBucket::~FillBucket() {
 }
 
 void FillBucket::addGeometry(const GeometryCollection& geometryCollection) {
-    for (auto& line_ : geometryCollection) {
-        for (auto& v : line_) {
-            line.emplace_back(v.x, v.y);
+    for (auto& ring : geometryCollection) {
+        rings.emplace_back(ring);
+        endRing();
+    }
+
+    tessellate();
+}
+
+void FillBucket::addGeometry(const GeometryTileFeature& feature) {
+    class Visitor : public GeometryVisitor {
+    public:
+        Visitor(FillBucket& bucket_) : bucket(bucket_) {}
+
+        void beginLine() override {
+            bucket.rings.emplace_back();
         }
-        if (!line.empty()) {
-            clipper.AddPath(line, ClipperLib::ptSubject, true);
-            line.clear();
-            hasVertices = true;
+
+        void addPoint(const Coordinate& point) override {
+            bucket.rings.back().push_back(point);
+        }
+
+        void endLine() override {
+            bucket.endRing();
         }
-    }
+
+    private:
+        FillBucket& bucket;
+    } visitor(*this);
+
+    visitGeometries(feature, visitor);
 
     tessellate();
 }
 
+void FillBucket::endRing() {
+    auto& ring = rings.back();
+
+    // Rings end with their first point.
+    if (ring.size() > 1 && ring.front() == ring.back()) {
+        ring.pop_back();
+    }
+
+    if (ring.size() < 3) {
+        rings.pop_back();
+    }
+}
+
+void FillBucket::simplifyRings() {
+    // Holes follow their outer ring, and are dropped along with it. Only called for features
+    // whose winding matches the nesting of their rings.
+    const bool outerWinding = util::signedArea(rings.front()) > 0;
+    bool keepHoles = true;
+
+    auto out = rings.begin();
+    for (auto& ring : rings) {
+        const bool outer = (util::signedArea(ring) > 0) == outerWinding;
+        if (!outer && !keepHoles) {
+            continue;
+        }
+
+        simplified.clear();
+        const bool kept = simplifier.simplifyRing(ring, simplified);
+        if (outer) {
+            keepHoles = kept;
+        }
+        if (kept) {
+            out->swap(simplified);
+            ++out;
+        }
+    }
+
+    rings.erase(out, rings.end());
+}
+
 void FillBucket::tessellate() {
-    if (!hasVertices) {
+    if (rings.empty()) {
+        return;
+    }
+
+    // Large polygons take a while to tessellate. Don't bother if the tile was discarded in the
+    // meantime.
+    if (cancellation && cancellation->cancelled()) {
+        cancellation->skippedFeatures(1);
+        rings.clear();
+        return;
+    }
+
+    auto addWithClipper = [&] (GeometryCollection::const_iterator first, GeometryCollection::const_iterator last) {
+        for (auto ring = first; ring != last; ++ring) {
+            for (const auto& point : *ring) {
+                line.emplace_back(point.x, point.y);
+            }
+            clipper.AddPath(line, ClipperLib::ptSubject, true);
+            line.clear();
+        }
+        tessellateWithClipper();
+    };
+
+    // Clipper fills by the even-odd rule, which doesn't depend on the winding of the rings.
+    // Such features aren't simplified either, as simplification drops holes by their winding.
+    if (!util::windingMatchesNesting(rings.cbegin(), rings.cend())) {
+        addWithClipper(rings.cbegin(), rings.cend());
+        rings.clear();
         return;
     }
-    hasVertices = false;
 
+    if (simplifier) {
+        simplifyRings();
+        if (rings.empty()) {
+            return;
+        }
+    }
+
+    // Every polygon of the feature is an outer ring followed by its holes, which are wound the
+    // other way. The first ring is always an outer ring.
+    const bool outerWinding = util::signedArea(rings.front()) > 0;
+
+    auto first = rings.cbegin();
+    for (auto it = std::next(first);; ++it) {
+        if (it == rings.cend() || (util::signedArea(*it) > 0) == outerWinding) {
+            // Ear clipping fails on self-intersecting polygons, which need to be resolved by
+            // Clipper before they can be tessellated.
+            if (!addPolygon(first, it)) {
+                addWithClipper(first, it);
+            }
+
+            if (it == rings.cend()) {
+                break;
+            }
+            first = it;
+        }
+    }
+
+    rings.clear();
+}
+
+bool FillBucket::addPolygon(GeometryCollection::const_iterator first, GeometryCollection::const_iterator last) {
+    GLsizei total_vertex_count = 0;
+    for (auto ring = first; ring != last; ++ring) {
+        total_vertex_count += ring->size();
+    }
+
+    if (total_vertex_count > triangleElementsBuffer.maxGroupVertices()) {
+        return false;
+    }
+
+    triangles.clear();
+    if (!earcut(first, last, triangles)) {
+        return false;
+    }
+
+    if (lineGroups.empty() || (lineGroups.back()->vertex_length + total_vertex_count > lineElementsBuffer.maxGroupVertices())) {
+        // Move to a new group because the old one can't hold the geometry.
+        lineGroups.emplace_back(std::make_unique<LineGroup>());
+    }
+
+    if (triangleGroups.empty() || (triangleGroups.back()->vertex_length + total_vertex_count > triangleElementsBuffer.maxGroupVertices())) {
+        // Move to a new group because the old one can't hold the geometry.
+        triangleGroups.emplace_back(std::make_unique<TriangleGroup>());
+    }
+
+    vertexBuffer.reserve(total_vertex_count);
+    lineElementsBuffer.reserve(total_vertex_count);
+    triangleElementsBuffer.reserve(triangles.size() / 3);
+
+    assert(lineGroups.back());
+    LineGroup& lineGroup = *lineGroups.back();
+    GLsizei lineIndex = lineGroup.vertex_length;
+
+    assert(triangleGroups.back());
+    TriangleGroup& triangleGroup = *triangleGroups.back();
+    const GLsizei triangleIndex = triangleGroup.vertex_length;
+
+    for (auto ring = first; ring != last; ++ring) {
+        const GLsizei group_count = static_cast<GLsizei>(ring->size());
+
+        for (const auto& pt : *ring) {
+            vertexBuffer.add(pt.x, pt.y);
+        }
+
+        for (GLsizei i = 0; i < group_count; i++) {
+            const GLsizei prev_i = (i == 0 ? group_count : i) - 1;
+            lineElementsBuffer.add(lineIndex + prev_i, lineIndex + i);
+        }
+
+        lineIndex += group_count;
+    }
+
+    for (std::size_t i = 0; i < triangles.size(); i += 3) {
+        triangleElementsBuffer.add(triangleIndex + triangles[i],
+                                   triangleIndex + triangles[i + 1],
+                                   triangleIndex + triangles[i + 2]);
+    }
+
+    lineGroup.vertex_length += total_vertex_count;
+    lineGroup.elements_length += total_vertex_count;
+    triangleGroup.vertex_length += total_vertex_count;
+    triangleGroup.elements_length += static_cast<GLsizei>(triangles.size() / 3);
+
+    return true;
+}
+
+void FillBucket::tessellateWithClipper() {
     std::vector<std::vector<ClipperLib::IntPoint>> polygons;
     clipper.Execute(ClipperLib::ctUnion, polygons, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
     clipper.Clear();
@@ -87,15 +274,18 @@ void FillBucket::tessellate() {
         total_vertex_count += polygon.size();
     }
 
-    if (total_vertex_count > 65536) {
+    if (total_vertex_count > triangleElementsBuffer.maxGroupVertices()) {
         throw geometry_too_long_exception();
     }
 
-    if (lineGroups.empty() || (lineGroups.back()->vertex_length + total_vertex_count > 65535)) {
+    if (lineGroups.empty() || (lineGroups.back()->vertex_length + total_vertex_count > lineElementsBuffer.maxGroupVertices())) {
         // Move to a new group because the old one can't hold the geometry.
         lineGroups.emplace_back(std::make_unique<LineGroup>());
     }
 
+    vertexBuffer.reserve(total_vertex_count);
+    lineElementsBuffer.reserve(total_vertex_count);
+
     assert(lineGroups.back());
     LineGroup& lineGroup = *lineGroups.back();
     GLsizei lineIndex = lineGroup.vertex_length;
@@ -138,7 +328,7 @@ void FillBucket::tessellate() {
             }
         }
 
-        if (triangleGroups.empty() || (triangleGroups.back()->vertex_length + total_vertex_count > 65535)) {
+        if (triangleGroups.empty() || (triangleGroups.back()->vertex_length + total_vertex_count > triangleElementsBuffer.maxGroupVertices())) {
             // Move to a new group because the old one can't hold the geometry.
             triangleGroups.emplace_back(std::make_unique<TriangleGroup>());
         }
@@ -206,15 +396,21 @@ bool FillBucket::hasData() const {
     return !triangleGroups.empty() || !lineGroups.empty();
 }
 
+std::size_t FillBucket::getByteSize() const {
+    return vertexBuffer.getByteSize() +
+           triangleElementsBuffer.getByteSize() +
+           lineElementsBuffer.getByteSize();
+}
+
 void FillBucket::drawElements(PlainShader& shader, gl::GLObjectStore& glObjectStore) {
     GLbyte* vertex_index = BUFFER_OFFSET(0);
     GLbyte* elements_index = BUFFER_OFFSET(0);
     for (auto& group : triangleGroups) {
         assert(group);
         group->array[0].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.getElementType(), elements_index));
+        vertex_index += group->vertex_length * vertexBuffer.getItemSize();
+        elements_index += group->elements_length * triangleElementsBuffer.getItemSize();
     }
 }
 
@@ -224,9 +420,9 @@ void FillBucket::drawElements(PatternShader& shader, gl::GLObjectStore& glObject
     for (auto& group : triangleGroups) {
         assert(group);
         group->array[1].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.getElementType(), elements_index));
+        vertex_index += group->vertex_length * vertexBuffer.getItemSize();
+        elements_index += group->elements_length * triangleElementsBuffer.getItemSize();
     }
 }
 
@@ -236,8 +432,8 @@ void FillBucket::drawVertices(OutlineShader& shader, gl::GLObjectStore& glObject
     for (auto& group : lineGroups) {
         assert(group);
         group->array[0].bind(shader, vertexBuffer, lineElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_LINES, group->elements_length * 2, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * lineElementsBuffer.itemSize;
+        MBGL_CHECK_ERROR(glDrawElements(GL_LINES, group->elements_length * 2, lineElementsBuffer.getElementType(), elements_index));
+        vertex_index += group->vertex_length * vertexBuffer.getItemSize();
+        elements_index += group->elements_length * lineElementsBuffer.getItemSize();
     }
 }
@@ -5,6 +5,8 @@
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/geometry/elements_buffer.hpp>
 #include <mbgl/geometry/fill_buffer.hpp>
+#include <mbgl/util/earcut.hpp>
+#include <mbgl/util/simplify.hpp>
 
 #include <clipper/clipper.hpp>
 #include <libtess2/tesselator.h>
@@ -18,6 +20,7 @@ class FillVertexBuffer;
 class OutlineShader;
 class PlainShader;
 class PatternShader;
+class TileCancellation;
 
 class FillBucket : public Bucket {
 
@@ -29,14 +32,18 @@ class FillBucket : public Bucket {
     typedef ElementGroup<1> LineGroup;
 
 public:
-    FillBucket();
+    // Tessellation is skipped once the cancellation reports that the tile became obsolete.
+    // Rings are simplified by the given tolerance in tile units.
+    explicit FillBucket(const TileCancellation* = nullptr, double simplificationTolerance = 0);
     ~FillBucket() override;
 
     void upload(gl::GLObjectStore&) override;
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
     bool hasData() const override;
+    std::size_t getByteSize() const override;
 
     void addGeometry(const GeometryCollection&);
+    void addGeometry(const GeometryTileFeature&);
     void tessellate();
 
     void drawElements(PlainShader&, gl::GLObjectStore&);
@@ -44,6 +51,13 @@ public:
     void drawVertices(OutlineShader&, gl::GLObjectStore&);
 
 private:
+    void endRing();
+    void simplifyRings();
+    bool addPolygon(GeometryCollection::const_iterator first, GeometryCollection::const_iterator last);
+    void tessellateWithClipper();
+
+    const TileCancellation* cancellation;
+
     TESSalloc *allocator;
     TESStesselator *tesselator;
     ClipperLib::Clipper clipper;
@@ -55,8 +69,16 @@ private:
     std::vector<std::unique_ptr<TriangleGroup>> triangleGroups;
     std::vector<std::unique_ptr<LineGroup>> lineGroups;
 
+    // The rings of the feature that is being added.
+    GeometryCollection rings;
+
+    util::Simplifier simplifier;
+    std::vector<Coordinate> simplified;
+
+    util::Earcut earcut;
+    std::vector<uint32_t> triangles;
+
     std::vector<ClipperLib::IntPoint> line;
-    bool hasVertices = false;
 
     static const int vertexSize = 2;
     static const int stride = sizeof(TESSreal) * vertexSize;
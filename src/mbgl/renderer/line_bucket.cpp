@@ -7,13 +7,16 @@
 #include <mbgl/shader/linepattern_shader.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/get_geometries.hpp>
 #include <mbgl/gl/gl.hpp>
 
 #include <cassert>
 
 using namespace mbgl;
 
-LineBucket::LineBucket(float overscaling_) : overscaling(overscaling_) {
+LineBucket::LineBucket(float overscaling_, double simplificationTolerance)
+    : simplifier(simplificationTolerance),
+      overscaling(overscaling_) {
 }
 
 LineBucket::~LineBucket() {
@@ -26,6 +29,29 @@ void LineBucket::addGeometry(const GeometryCollection& geometryCollection) {
     }
 }
 
+void LineBucket::addGeometry(const GeometryTileFeature& feature) {
+    class Visitor : public GeometryVisitor {
+    public:
+        Visitor(LineBucket& bucket_) : bucket(bucket_) {}
+
+        void beginLine() override {}
+
+        void addPoint(const Coordinate& point) override {
+            bucket.line.push_back(point);
+        }
+
+        void endLine() override {
+            bucket.addGeometry(bucket.line);
+            bucket.line.clear();
+        }
+
+    private:
+        LineBucket& bucket;
+    } visitor(*this);
+
+    visitGeometries(feature, visitor);
+}
+
 
 /*
  * Sharp corners cause dashed lines to tilt because the distance along the line
@@ -41,7 +67,16 @@ void LineBucket::addGeometry(const GeometryCollection& geometryCollection) {
 const float COS_HALF_SHARP_CORNER = std::cos(75.0 / 2.0 * (M_PI / 180.0));
 const float SHARP_CORNER_OFFSET = 15.0f;
 
-void LineBucket::addGeometry(const std::vector<Coordinate>& vertices) {
+void LineBucket::addGeometry(const std::vector<Coordinate>& input) {
+    const std::vector<Coordinate>& vertices = [&]() -> const std::vector<Coordinate>& {
+        if (!simplifier) {
+            return input;
+        }
+        simplified.clear();
+        simplifier.simplifyLine(input, simplified);
+        return simplified;
+    }();
+
     const GLsizei len = [&vertices] {
         GLsizei l = static_cast<GLsizei>(vertices.size());
         // If the line has duplicate vertices at the end, adjust length to remove them.
@@ -87,6 +122,9 @@ void LineBucket::addGeometry(const std::vector<Coordinate>& vertices) {
         nextNormal = util::perp(util::unit(vec2<double>(firstVertex - currentVertex)));
     }
 
+    // Most vertices produce two extrusion vertices, round and square joins produce more.
+    vertexBuffer.reserve(len * 2);
+
     const GLint startVertex = vertexBuffer.index();
     std::vector<TriangleElement> triangleStore;
 
@@ -343,13 +381,14 @@ void LineBucket::addGeometry(const std::vector<Coordinate>& vertices) {
 
     // Store the triangle/line groups.
     {
-        if (triangleGroups.empty() || (triangleGroups.back()->vertex_length + vertexCount > 65535)) {
+        if (triangleGroups.empty() || (triangleGroups.back()->vertex_length + vertexCount > triangleElementsBuffer.maxGroupVertices())) {
             // Move to a new group because the old one can't hold the geometry.
             triangleGroups.emplace_back(std::make_unique<TriangleGroup>());
         }
 
         assert(triangleGroups.back());
         auto& group = *triangleGroups.back();
+        triangleElementsBuffer.reserve(triangleStore.size());
         for (const auto& triangle : triangleStore) {
             triangleElementsBuffer.add(group.vertex_length + triangle.a,
                                        group.vertex_length + triangle.b,
@@ -437,6 +476,10 @@ bool LineBucket::hasData() const {
     return !triangleGroups.empty();
 }
 
+std::size_t LineBucket::getByteSize() const {
+    return vertexBuffer.getByteSize() + triangleElementsBuffer.getByteSize();
+}
+
 void LineBucket::drawLines(LineShader& shader, gl::GLObjectStore& glObjectStore) {
     GLbyte* vertex_index = BUFFER_OFFSET(0);
     GLbyte* elements_index = BUFFER_OFFSET(0);
@@ -446,10 +489,10 @@ void LineBucket::drawLines(LineShader& shader, gl::GLObjectStore& glObjectStore)
             continue;
         }
         group->array[0].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.getElementType(),
                                         elements_index));
-        vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        vertex_index += group->vertex_length * vertexBuffer.getItemSize();
+        elements_index += group->elements_length * triangleElementsBuffer.getItemSize();
     }
 }
 
@@ -462,10 +505,10 @@ void LineBucket::drawLineSDF(LineSDFShader& shader, gl::GLObjectStore& glObjectS
             continue;
         }
         group->array[2].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.getElementType(),
                                         elements_index));
-        vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        vertex_index += group->vertex_length * vertexBuffer.getItemSize();
+        elements_index += group->elements_length * triangleElementsBuffer.getItemSize();
     }
 }
 
@@ -478,9 +521,9 @@ void LineBucket::drawLinePatterns(LinepatternShader& shader, gl::GLObjectStore&
             continue;
         }
         group->array[1].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.getElementType(),
                                         elements_index));
-        vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        vertex_index += group->vertex_length * vertexBuffer.getItemSize();
+        elements_index += group->elements_length * triangleElementsBuffer.getItemSize();
     }
 }
@@ -7,6 +7,7 @@
 #include <mbgl/geometry/elements_buffer.hpp>
 #include <mbgl/geometry/line_buffer.hpp>
 #include <mbgl/util/vec.hpp>
+#include <mbgl/util/simplify.hpp>
 #include <mbgl/layer/line_layer.hpp>
 
 #include <vector>
@@ -24,14 +25,17 @@ class LineBucket : public Bucket {
     using TriangleGroup = ElementGroup<3>;
 
 public:
-    LineBucket(float overscaling);
+    // Lines are simplified by the given tolerance in tile units.
+    LineBucket(float overscaling, double simplificationTolerance = 0);
     ~LineBucket() override;
 
     void upload(gl::GLObjectStore&) override;
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
     bool hasData() const override;
+    std::size_t getByteSize() const override;
 
     void addGeometry(const GeometryCollection&);
+    void addGeometry(const GeometryTileFeature&);
     void addGeometry(const std::vector<Coordinate>& line);
 
     void drawLines(LineShader&, gl::GLObjectStore&);
@@ -63,6 +67,12 @@ private:
 
     std::vector<std::unique_ptr<TriangleGroup>> triangleGroups;
 
+    // Holds the line that is currently being streamed from a feature.
+    std::vector<Coordinate> line;
+
+    util::Simplifier simplifier;
+    std::vector<Coordinate> simplified;
+
     const float overscaling;
 };
 
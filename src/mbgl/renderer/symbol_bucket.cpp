@@ -1,6 +1,7 @@
 #include <mbgl/renderer/symbol_bucket.hpp>
 #include <mbgl/layer/symbol_layer.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/tile/tile_cancellation.hpp>
 #include <mbgl/sprite/sprite_image.hpp>
 #include <mbgl/sprite/sprite_store.hpp>
 #include <mbgl/sprite/sprite_atlas.hpp>
@@ -86,6 +87,19 @@ void SymbolBucket::render(Painter& painter,
 
 bool SymbolBucket::hasData() const { return hasTextData() || hasIconData() || !symbolInstances.empty(); }
 
+std::size_t SymbolBucket::getByteSize() const {
+    // Only the buffers that are being rendered are counted: the ones in progress belong to
+    // a placement that is still running on a worker thread.
+    if (!renderData) {
+        return 0;
+    }
+    return renderData->text.vertices.getByteSize() +
+           renderData->text.triangles.getByteSize() +
+           renderData->icon.vertices.getByteSize() +
+           renderData->icon.triangles.getByteSize() +
+           renderData->collisionBox.vertices.getByteSize();
+}
+
 bool SymbolBucket::hasTextData() const { return renderData && !renderData->text.groups.empty(); }
 
 bool SymbolBucket::hasIconData() const { return renderData && !renderData->icon.groups.empty(); }
@@ -93,7 +107,8 @@ bool SymbolBucket::hasIconData() const { return renderData && !renderData->icon.
 bool SymbolBucket::hasCollisionBoxData() const { return renderData && !renderData->collisionBox.groups.empty(); }
 
 void SymbolBucket::parseFeatures(const GeometryTileLayer& layer,
-                                 const FilterExpression& filter) {
+                                 const FilterExpression& filter,
+                                 const TileCancellation& cancellation) {
     const bool has_text = !layout.text.field.value.empty() && !layout.text.font.value.empty();
     const bool has_icon = !layout.icon.image.value.empty();
 
@@ -101,19 +116,31 @@ void SymbolBucket::parseFeatures(const GeometryTileLayer& layer,
         return;
     }
 
-    // Determine and load glyph ranges
-    const GLsizei featureCount = static_cast<GLsizei>(layer.featureCount());
-    for (GLsizei i = 0; i < featureCount; i++) {
-        auto feature = layer.getFeature(i);
+    // Resolve the keys used by the filter and the token templates before visiting any features.
+    std::vector<std::string> tokens;
+    auto collectToken = [&](const std::string& key) -> std::string {
+        tokens.push_back(key);
+        return {};
+    };
+    if (has_text) util::replaceTokens(layout.text.field, collectToken);
+    if (has_icon) util::replaceTokens(layout.icon.image, collectToken);
+
+    GeometryTileLayerKeys keys(layer);
+    keys.add(filter);
+    for (const auto& token : tokens) {
+        keys.add(token);
+    }
 
-        GeometryTileFeatureExtractor extractor(*feature);
+    // Determine and load glyph ranges
+    const std::size_t visited = layer.eachFeature([&] (const GeometryTileFeature& feature) {
+        GeometryTileFeatureExtractor extractor(feature, &keys);
         if (!evaluate(filter, extractor))
-            continue;
+            return;
 
         SymbolFeature ft;
 
-        auto getValue = [&feature](const std::string& key) -> std::string {
-            auto value = feature->getValue(key);
+        auto getValue = [&](const std::string& key) -> std::string {
+            auto value = keys.getValue(feature, key);
             return value ? toString(*value) : std::string();
         };
 
@@ -141,20 +168,18 @@ void SymbolBucket::parseFeatures(const GeometryTileLayer& layer,
         }
 
         if (ft.label.length() || ft.sprite.length()) {
+            GeometryCollectionBuilder builder(ft.geometry);
+            visitGeometries(feature, builder);
 
-            auto &multiline = ft.geometry;
-
-            GeometryCollection geometryCollection = getGeometries(*feature);
-            for (auto& line : geometryCollection) {
-                multiline.emplace_back();
-                for (auto& point : line) {
-                    multiline.back().emplace_back(point.x, point.y);
-                }
+            // Features without any geometry can't produce symbols.
+            if (!ft.geometry.empty()) {
+                features.push_back(std::move(ft));
             }
-
-            features.push_back(std::move(ft));
         }
-    }
+    }, [&] {
+        return cancellation.cancelled();
+    });
+    cancellation.skippedFeatures(layer.featureCount() - visited);
 
     if (layout.placement == PlacementType::Line) {
         util::mergeLines(features);
@@ -176,7 +201,8 @@ bool SymbolBucket::needsDependencies(GlyphStore& glyphStore, SpriteStore& sprite
 void SymbolBucket::addFeatures(uintptr_t tileUID,
                                SpriteAtlas& spriteAtlas,
                                GlyphAtlas& glyphAtlas,
-                               GlyphStore& glyphStore) {
+                               GlyphStore& glyphStore,
+                               const TileCancellation& cancellation) {
     float horizontalAlign = 0.5;
     float verticalAlign = 0.5;
 
@@ -220,7 +246,13 @@ void SymbolBucket::addFeatures(uintptr_t tileUID,
 
     auto fontStack = glyphStore.getFontStack(layout.text.font);
 
-    for (const auto& feature : features) {
+    for (auto it = features.begin(); it != features.end(); ++it) {
+        if (cancellation.cancelled()) {
+            cancellation.skippedFeatures(features.end() - it);
+            break;
+        }
+
+        const auto& feature = *it;
         if (feature.geometry.empty()) continue;
 
         Shaping shapedText;
@@ -357,7 +389,7 @@ bool SymbolBucket::anchorIsTooClose(const std::u32string &text, const float repe
     return false;
 }
 
-void SymbolBucket::placeFeatures(CollisionTile& collisionTile) {
+void SymbolBucket::placeFeatures(CollisionTile& collisionTile, const TileCancellation& cancellation) {
 
     renderDataInProgress = std::make_unique<SymbolRenderData>();
 
@@ -391,7 +423,14 @@ void SymbolBucket::placeFeatures(CollisionTile& collisionTile) {
         });
     }
 
-    for (SymbolInstance &symbolInstance : symbolInstances) {
+    for (auto it = symbolInstances.begin(); it != symbolInstances.end(); ++it) {
+        // The placement of an obsolete tile is never shown, so partial render data is fine.
+        if (cancellation.cancelled()) {
+            cancellation.skippedSymbols(symbolInstances.end() - it);
+            return;
+        }
+
+        SymbolInstance& symbolInstance = *it;
 
         const bool hasText = symbolInstance.hasText;
         const bool hasIcon = symbolInstance.hasIcon;
@@ -485,7 +524,7 @@ void SymbolBucket::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float
 
         const int glyph_vertex_length = 4;
 
-        if (buffer.groups.empty() || (buffer.groups.back()->vertex_length + glyph_vertex_length > 65535)) {
+        if (buffer.groups.empty() || (buffer.groups.back()->vertex_length + glyph_vertex_length > buffer.triangles.maxGroupVertices())) {
             // Move to a new group because the old one can't hold the geometry.
             buffer.groups.emplace_back(std::make_unique<GroupType>());
         }
@@ -579,9 +618,9 @@ void SymbolBucket::drawGlyphs(SDFShader& shader, gl::GLObjectStore& glObjectStor
     for (auto &group : text.groups) {
         assert(group);
         group->array[0].bind(shader, text.vertices, text.triangles, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * text.vertices.itemSize;
-        elements_index += group->elements_length * text.triangles.itemSize;
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, text.triangles.getElementType(), elements_index));
+        vertex_index += group->vertex_length * text.vertices.getItemSize();
+        elements_index += group->elements_length * text.triangles.getItemSize();
     }
 }
 
@@ -592,9 +631,9 @@ void SymbolBucket::drawIcons(SDFShader& shader, gl::GLObjectStore& glObjectStore
     for (auto &group : icon.groups) {
         assert(group);
         group->array[0].bind(shader, icon.vertices, icon.triangles, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * icon.vertices.itemSize;
-        elements_index += group->elements_length * icon.triangles.itemSize;
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, icon.triangles.getElementType(), elements_index));
+        vertex_index += group->vertex_length * icon.vertices.getItemSize();
+        elements_index += group->elements_length * icon.triangles.getItemSize();
     }
 }
 
@@ -605,9 +644,9 @@ void SymbolBucket::drawIcons(IconShader& shader, gl::GLObjectStore& glObjectStor
     for (auto &group : icon.groups) {
         assert(group);
         group->array[1].bind(shader, icon.vertices, icon.triangles, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * icon.vertices.itemSize;
-        elements_index += group->elements_length * icon.triangles.itemSize;
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, icon.triangles.getElementType(), elements_index));
+        vertex_index += group->vertex_length * icon.vertices.getItemSize();
+        elements_index += group->elements_length * icon.triangles.getItemSize();
     }
 }
 
@@ -32,6 +32,7 @@ class SpriteAtlas;
 class SpriteStore;
 class GlyphAtlas;
 class GlyphStore;
+class TileCancellation;
 
 class SymbolFeature {
 public:
@@ -73,6 +74,7 @@ public:
     void upload(gl::GLObjectStore&) override;
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
     bool hasData() const override;
+    std::size_t getByteSize() const override;
     bool hasTextData() const;
     bool hasIconData() const;
     bool hasCollisionBoxData() const;
@@ -80,7 +82,8 @@ public:
     void addFeatures(uintptr_t tileUID,
                      SpriteAtlas&,
                      GlyphAtlas&,
-                     GlyphStore&);
+                     GlyphStore&,
+                     const TileCancellation&);
 
     void drawGlyphs(SDFShader&, gl::GLObjectStore&);
     void drawIcons(SDFShader&, gl::GLObjectStore&);
@@ -88,9 +91,10 @@ public:
     void drawCollisionBoxes(CollisionBoxShader&, gl::GLObjectStore&);
 
     void parseFeatures(const GeometryTileLayer&,
-                       const FilterExpression&);
+                       const FilterExpression&,
+                       const TileCancellation&);
     bool needsDependencies(GlyphStore&, SpriteStore&);
-    void placeFeatures(CollisionTile&) override;
+    void placeFeatures(CollisionTile&, const TileCancellation&) override;
 
 private:
     void addFeature(const std::vector<std::vector<Coordinate>> &lines,
@@ -33,9 +33,17 @@
 
 #include <algorithm>
 #include <sstream>
+#include <unordered_set>
 
 namespace mbgl {
 
+namespace {
+
+// Ancestors of the tiles in view are pinned this many zoom levels above them.
+const int32_t pinnedParentDeltas[] = { 2, 4 };
+
+} // namespace
+
 Source::Source(SourceType type_,
                const std::string& id_,
                const std::string& url_,
@@ -148,9 +156,16 @@ void Source::load(FileSource& fileSource) {
                 tilePtrs.clear();
                 tileDataMap.clear();
                 tiles.clear();
-                cache.clear();
+                zoomTileCounts.clear();
+                prefetchedTiles.clear();
+                pinnedParentTiles.clear();
+                transitionPath = nullptr;
+                cacheInvalidated = true;
             }
 
+            // The zoom range may have changed.
+            coverState = {};
+
             loaded = true;
             observer->onSourceLoaded(*this);
         }
@@ -199,6 +214,10 @@ TileData::State Source::hasTile(const TileID& tileID) {
     return TileData::State::invalid;
 }
 
+bool Source::hasTilesAtZoom(int32_t z) const {
+    return z >= 0 && z < int32_t(zoomTileCounts.size()) && zoomTileCounts[z] > 0;
+}
+
 bool Source::handlePartialTile(const TileID& tileID) {
     auto it = tileDataMap.find(tileID.normalized());
     if (it == tileDataMap.end()) {
@@ -223,68 +242,84 @@ TileData::State Source::addTile(const TileID& tileID, const StyleUpdateParameter
         return state;
     }
 
+    // We couldn't find the tile in the list. Create a new one.
     auto newTile = std::make_unique<Tile>(tileID);
+    newTile->data = getTileData(tileID.normalized(), parameters);
+    if (!newTile->data) {
+        return TileData::State::invalid;
+    }
 
-    // We couldn't find the tile in the list. Create a new one.
-    // Try to find the associated TileData object.
-    const TileID normalizedID = tileID.normalized();
+    const auto newState = newTile->data->getState();
+    tiles.emplace(tileID, std::move(newTile));
+
+    if (zoomTileCounts.size() <= std::size_t(tileID.z)) {
+        zoomTileCounts.resize(tileID.z + 1, 0);
+    }
+    zoomTileCounts[tileID.z]++;
 
+    return newState;
+}
+
+std::shared_ptr<TileData> Source::getTileData(const TileID& normalizedID, const StyleUpdateParameters& parameters) {
+    std::shared_ptr<TileData> data;
+
+    // Try to find the associated TileData object.
     auto it = tileDataMap.find(normalizedID);
     if (it != tileDataMap.end()) {
         // Create a shared_ptr handle. Note that this might be empty!
-        newTile->data = it->second.lock();
+        data = it->second.lock();
     }
 
-    if (newTile->data && newTile->data->getState() == TileData::State::obsolete) {
+    if (data && data->getState() == TileData::State::obsolete) {
         // Do not consider the tile if it's already obsolete.
-        newTile->data.reset();
+        data.reset();
     }
 
-    if (!newTile->data) {
-        newTile->data = cache.get(normalizedID.to_uint64());
+    if (!data) {
+        data = parameters.tileCache.get(id, normalizedID.to_uint64());
     }
 
-    if (!newTile->data) {
+    if (!data) {
         auto callback = std::bind(&Source::tileLoadingCallback, this, normalizedID,
                                   std::placeholders::_1, true);
 
         // If we don't find working tile data, we're just going to load it.
         if (type == SourceType::Raster) {
-            newTile->data = std::make_shared<RasterTileData>(normalizedID,
-                                                             parameters.pixelRatio,
-                                                             info->tiles.at(0),
-                                                             parameters.texturePool,
-                                                             parameters.worker,
-                                                             parameters.fileSource,
-                                                             callback);
+            data = std::make_shared<RasterTileData>(normalizedID,
+                                                    parameters.pixelRatio,
+                                                    info->tiles.at(0),
+                                                    parameters.texturePool,
+                                                    parameters.worker,
+                                                    parameters.fileSource,
+                                                    callback);
         } else {
             std::unique_ptr<GeometryTileMonitor> monitor;
 
             if (type == SourceType::Vector) {
-                monitor = std::make_unique<VectorTileMonitor>(normalizedID, parameters.pixelRatio, info->tiles.at(0), parameters.fileSource);
+                monitor = std::make_unique<VectorTileMonitor>(normalizedID, parameters.pixelRatio, info->tiles.at(0), parameters.fileSource,
+                                                     parameters.data.sharedTileCache.get());
             } else if (type == SourceType::Annotations) {
                 monitor = std::make_unique<AnnotationTileMonitor>(normalizedID, parameters.data);
             } else if (type == SourceType::GeoJSON) {
                 monitor = std::make_unique<GeoJSONTileMonitor>(geojsonvt.get(), normalizedID);
             } else {
                 Log::Warning(Event::Style, "Source type '%s' is not implemented", SourceTypeClass(type).c_str());
-                return TileData::State::invalid;
+                return nullptr;
             }
 
-            newTile->data = std::make_shared<VectorTileData>(normalizedID,
-                                                             std::move(monitor),
-                                                             id,
-                                                             parameters.style,
-                                                             parameters.mode,
-                                                             callback);
+            data = std::make_shared<VectorTileData>(normalizedID,
+                                                    std::move(monitor),
+                                                    id,
+                                                    parameters.style,
+                                                    parameters.mode,
+                                                    parameters.data.getGeometrySimplification(),
+                                                    callback);
         }
 
-        tileDataMap.emplace(newTile->data->id, newTile->data);
+        tileDataMap.emplace(data->id, data);
     }
 
-    const auto newState = newTile->data->getState();
-    tiles.emplace(tileID, std::move(newTile));
-    return newState;
+    return data;
 }
 
 /**
@@ -296,14 +331,25 @@ TileData::State Source::addTile(const TileID& tileID, const StyleUpdateParameter
  *
  * @return boolean Whether the children found completely cover the tile.
  */
-bool Source::findLoadedChildren(const TileID& tileID, int32_t maxCoveringZoom, std::vector<TileID>& retain) {
-    bool complete = true;
+bool Source::findLoadedChildren(const TileID& tileID, int32_t maxCoveringZoom, std::unordered_set<TileID>& retain) {
     int32_t z = tileID.z;
+
+    // Don't enumerate children on levels where we don't have any tiles.
+    bool hasChildren = false;
+    const int32_t maxChildZ = std::max(z, maxCoveringZoom) + 1;
+    for (int32_t childZ = z + 1; childZ <= maxChildZ && !hasChildren; ++childZ) {
+        hasChildren = hasTilesAtZoom(childZ);
+    }
+    if (!hasChildren) {
+        return false;
+    }
+
+    bool complete = true;
     auto ids = tileID.children(info->maxZoom);
     for (const auto& child_id : ids) {
         const TileData::State state = hasTile(child_id);
         if (TileData::isReadyState(state)) {
-            retain.emplace_back(child_id);
+            retain.emplace(child_id);
         }
         if (state != TileData::State::parsed) {
             complete = false;
@@ -325,12 +371,32 @@ bool Source::findLoadedChildren(const TileID& tileID, int32_t maxCoveringZoom, s
  *
  * @return boolean Whether a parent was found.
  */
-void Source::findLoadedParent(const TileID& tileID, int32_t minCoveringZoom, std::vector<TileID>& retain) {
+void Source::findLoadedParent(const TileID& tileID, int32_t minCoveringZoom, std::unordered_set<TileID>& retain,
+                              const StyleUpdateParameters& parameters) {
+    // Pinned parents only exist at fixed distances from the tile, so other empty levels can
+    // still be skipped while some parents are pinned.
+    const int32_t pinnedZoom = std::min<int32_t>(tileID.z, info->maxZoom);
+    auto isPinnedLevel = [&] (int32_t z) {
+        return !pinnedParentTiles.empty() &&
+               std::find(std::begin(pinnedParentDeltas), std::end(pinnedParentDeltas), pinnedZoom - z) !=
+                   std::end(pinnedParentDeltas);
+    };
+
     for (int32_t z = tileID.z - 1; z >= minCoveringZoom; --z) {
+        if (!hasTilesAtZoom(z) && !isPinnedLevel(z)) {
+            continue;
+        }
         const TileID parent_id = tileID.parent(z, info->maxZoom);
-        const TileData::State state = hasTile(parent_id);
+        TileData::State state = hasTile(parent_id);
+        if (state == TileData::State::invalid) {
+            // Draw a pinned parent once it has loaded.
+            auto it = pinnedParentTiles.find(parent_id.normalized());
+            if (it != pinnedParentTiles.end() && TileData::isReadyState(it->second->getState())) {
+                state = addTile(parent_id, parameters);
+            }
+        }
         if (TileData::isReadyState(state)) {
-            retain.emplace_back(parent_id);
+            retain.emplace(parent_id);
             if (state == TileData::State::parsed) {
                 return;
             }
@@ -338,6 +404,95 @@ void Source::findLoadedParent(const TileID& tileID, int32_t minCoveringZoom, std
     }
 }
 
+std::vector<TileID> Source::coveringTileIDs(const TransformState& transformState) const {
+    int32_t zoom = coveringZoomLevel(transformState.getZoom(), type, tileSize);
+    if (zoom < info->minZoom) {
+        return {};
+    }
+
+    const bool reparseOverscaled =
+        type == SourceType::Vector ||
+        type == SourceType::Annotations;
+
+    const auto actualZ = zoom;
+    if (zoom > info->maxZoom) {
+        zoom = info->maxZoom;
+    }
+
+    return tileCover(transformState, zoom, reparseOverscaled ? actualZ : zoom);
+}
+
+void Source::updatePrefetchedTiles(const StyleUpdateParameters& parameters) {
+    if (parameters.transitionPath == transitionPath) {
+        return;
+    }
+    transitionPath = parameters.transitionPath;
+
+    // Tiles that are no longer on the path are cancelled below, like any other tile that is no
+    // longer retained, unless they are needed for the current frame.
+    std::vector<std::shared_ptr<TileData>> prefetched;
+    if (transitionPath && !transitionPath->empty() && parameters.mode == MapMode::Continuous) {
+        std::unordered_set<TileID> seen;
+
+        // The destination of the animation is where the camera stays; load it first, then the
+        // tiles along the way in the order in which they will be needed.
+        auto prefetch = [&] (const TransformState& state) {
+            for (const auto& tileID : coveringTileIDs(state)) {
+                const TileID normalizedID = tileID.normalized();
+                if (prefetched.size() < maxPrefetchedTiles && seen.insert(normalizedID).second) {
+                    if (auto data = getTileData(normalizedID, parameters)) {
+                        prefetched.push_back(std::move(data));
+                    }
+                }
+            }
+        };
+
+        prefetch(transitionPath->back());
+        for (auto it = transitionPath->begin(); it + 1 < transitionPath->end(); ++it) {
+            prefetch(*it);
+        }
+    }
+
+    prefetchedTiles = std::move(prefetched);
+}
+
+void Source::updatePinnedParentTiles(const StyleUpdateParameters& parameters) {
+    std::unordered_map<TileID, std::shared_ptr<TileData>> pinned;
+
+    if (pinningParentTiles) {
+        for (const auto& tileID : coveringTiles) {
+            for (int32_t delta : pinnedParentDeltas) {
+                const int32_t z = std::min<int32_t>(tileID.z, info->maxZoom) - delta;
+                if (z < info->minZoom) {
+                    break;
+                }
+
+                const TileID parentID = tileID.parent(z, info->maxZoom).normalized();
+                if (pinned.find(parentID) != pinned.end()) {
+                    continue;
+                }
+
+                auto it = pinnedParentTiles.find(parentID);
+                auto data = it != pinnedParentTiles.end() ? it->second : getTileData(parentID, parameters);
+                if (data) {
+                    pinned.emplace(parentID, std::move(data));
+                }
+            }
+        }
+    }
+
+    // Parents that are no longer pinned move to the TileCache, unless they're still in use.
+    for (auto& pair : pinnedParentTiles) {
+        const auto& data = pair.second;
+        if (pinned.find(pair.first) == pinned.end() && data.use_count() == 1 &&
+            data->getState() == TileData::State::parsed) {
+            parameters.tileCache.add(id, pair.first.to_uint64(), data);
+        }
+    }
+
+    pinnedParentTiles = std::move(pinned);
+}
+
 bool Source::update(const StyleUpdateParameters& parameters) {
     bool allTilesUpdated = true;
 
@@ -345,29 +500,32 @@ bool Source::update(const StyleUpdateParameters& parameters) {
         return allTilesUpdated;
     }
 
+    if (cacheInvalidated) {
+        parameters.tileCache.clear(id);
+        cacheInvalidated = false;
+    }
+
     // Determine the overzooming/underzooming amounts and required tiles.
-    std::vector<TileID> required;
-    int32_t zoom = coveringZoomLevel(parameters.transformState.getZoom(), type, tileSize);
+    const TransformState& transformState = parameters.transformState;
+    const int32_t zoom = coveringZoomLevel(transformState.getZoom(), type, tileSize);
     int32_t minCoveringZoom = util::clamp<int32_t>(zoom - 10, info->minZoom, info->maxZoom);
     int32_t maxCoveringZoom = util::clamp<int32_t>(zoom + 1,  info->minZoom, info->maxZoom);
 
-    if (zoom >= info->minZoom) {
-        const bool reparseOverscaled =
-            type == SourceType::Vector ||
-            type == SourceType::Annotations;
+    const bool pinParentTiles = parameters.data.getPrefetchParentTiles() && parameters.mode == MapMode::Continuous;
 
-        const auto actualZ = zoom;
-        if (zoom > info->maxZoom) {
-            zoom = info->maxZoom;
-        }
-
-        required = tileCover(parameters.transformState, zoom, reparseOverscaled ? actualZ : zoom);
+    if (!coverState || !coverState->hasSameView(transformState) || pinParentTiles != pinningParentTiles) {
+        coveringTiles = coveringTileIDs(transformState);
+        coverState = transformState;
+        pinningParentTiles = pinParentTiles;
+        updatePinnedParentTiles(parameters);
     }
 
-    // Retain is a list of tiles that we shouldn't delete, even if they are not
+    const std::vector<TileID>& required = coveringTiles;
+
+    // Retain is a set of tiles that we shouldn't delete, even if they are not
     // the most ideal tile for the current viewport. This may include tiles like
     // parent or child tiles that are *already* loaded.
-    std::vector<TileID> retain(required);
+    std::unordered_set<TileID> retain(required.begin(), required.end());
 
     // Add existing child/parent tiles if the actual tile is not yet loaded
     for (const auto& tileID : required) {
@@ -399,40 +557,76 @@ bool Source::update(const StyleUpdateParameters& parameters) {
             // Then, if there are no complete child tiles, try to find existing
             // parent tiles that completely cover the missing tile.
             if (!complete) {
-                findLoadedParent(tileID, minCoveringZoom, retain);
+                findLoadedParent(tileID, minCoveringZoom, retain, parameters);
             }
         }
     }
 
-    if (type != SourceType::Raster && cache.getSize() == 0) {
-        size_t conservativeCacheSize = ((float)parameters.transformState.getWidth()  / util::tileSize) *
-                                       ((float)parameters.transformState.getHeight() / util::tileSize) *
-                                       (parameters.transformState.getMaxZoom() - parameters.transformState.getMinZoom() + 1) *
-                                       0.5;
-        cache.setSize(conservativeCacheSize);
+    // tileCover() returns the required tiles sorted by distance from the center of the viewport.
+    // Rank them in that order, so that the tiles the user is looking at are loaded and parsed
+    // first. Wrapped copies of a tile share their TileData, which keeps the best rank.
+    std::unordered_set<TileData*> ranked;
+    int32_t priority = 0;
+    for (const auto& tileID : required) {
+        auto it = tiles.find(tileID);
+        if (it != tiles.end() && ranked.insert(it->second->data.get()).second) {
+            it->second->data->setPriority(priority++);
+        }
+    }
+
+    // Pinned parents rank right after the tiles of the current frame, followed by the tiles
+    // along the camera animation.
+    for (const auto& tileID : required) {
+        for (int32_t delta : pinnedParentDeltas) {
+            const int32_t z = std::min<int32_t>(tileID.z, info->maxZoom) - delta;
+            if (pinnedParentTiles.empty() || z < info->minZoom) {
+                break;
+            }
+            auto it = pinnedParentTiles.find(tileID.parent(z, info->maxZoom).normalized());
+            if (it != pinnedParentTiles.end() && ranked.insert(it->second.get()).second) {
+                it->second->setPriority(priority++);
+            }
+        }
     }
 
-    auto& tileCache = cache;
+    updatePrefetchedTiles(parameters);
+    for (const auto& data : prefetchedTiles) {
+        if (ranked.insert(data.get()).second) {
+            data->setPriority(priority++);
+        }
+    }
+
+    auto& tileCache = parameters.tileCache;
 
     // Remove tiles that we definitely don't need, i.e. tiles that are not on
     // the required list.
     std::set<TileID> retain_data;
     util::erase_if(tiles, [this, &retain, &retain_data, &tileCache](std::pair<const TileID, std::unique_ptr<Tile>> &pair) {
         Tile &tile = *pair.second;
-        bool obsolete = std::find(retain.begin(), retain.end(), tile.id) == retain.end();
+        bool obsolete = retain.find(tile.id) == retain.end();
         if (!obsolete) {
             retain_data.insert(tile.data->id);
-        } else if (type != SourceType::Raster && tile.data->getState() == TileData::State::parsed) {
-            // Partially parsed tiles are never added to the cache because otherwise
-            // they never get updated if the go out from the viewport and the pending
-            // resources arrive.
-            tileCache.add(tile.id.normalized().to_uint64(), tile.data);
+        } else {
+            zoomTileCounts[tile.id.z]--;
+            if (tile.data->getState() == TileData::State::parsed) {
+                // Partially parsed tiles are never added to the cache because otherwise
+                // they never get updated if the go out from the viewport and the pending
+                // resources arrive.
+                tileCache.add(id, tile.id.normalized().to_uint64(), tile.data);
+            }
         }
         return obsolete;
     });
 
+    for (const auto& data : prefetchedTiles) {
+        retain_data.insert(data->id);
+    }
+    for (const auto& pair : pinnedParentTiles) {
+        retain_data.insert(pair.second->id);
+    }
+
     // Remove all the expired pointers from the set.
-    util::erase_if(tileDataMap, [&retain_data, &tileCache](std::pair<const TileID, std::weak_ptr<TileData>> &pair) {
+    util::erase_if(tileDataMap, [this, &retain_data, &tileCache](std::pair<const TileID, std::weak_ptr<TileData>> &pair) {
         const util::ptr<TileData> tile = pair.second.lock();
         if (!tile) {
             return true;
@@ -440,7 +634,7 @@ bool Source::update(const StyleUpdateParameters& parameters) {
 
         bool obsolete = retain_data.find(tile->id) == retain_data.end();
         if (obsolete) {
-            if (!tileCache.has(tile->id.normalized().to_uint64())) {
+            if (!tileCache.has(id, tile->id.normalized().to_uint64())) {
                 tile->cancel();
             }
             return true;
@@ -450,20 +644,98 @@ bool Source::update(const StyleUpdateParameters& parameters) {
     });
 
     updateTilePtrs();
-
-    for (auto& tilePtr : tilePtrs) {
-        tilePtr->data->redoPlacement(
-            { parameters.transformState.getAngle(), parameters.transformState.getPitch(), parameters.debugOptions & MapDebugOptions::Collision },
-            [this]() {
-                observer->onPlacementRedone();
-            });
-    }
+    redoPlacement(parameters);
 
     updated = parameters.animationTime;
 
     return allTilesUpdated;
 }
 
+void Source::redoPlacement(const StyleUpdateParameters& parameters) {
+    const PlacementConfig config {
+        parameters.transformState.getAngle(),
+        parameters.transformState.getPitch(),
+        parameters.debugOptions & MapDebugOptions::Collision,
+        parameters.transformState.isRotating() || parameters.transformState.isGestureInProgress()
+    };
+
+    auto callback = [this]() {
+        observer->onPlacementRedone();
+    };
+
+    // Wrapped copies of a tile share their TileData, which is placed once.
+    std::vector<TileData*> placing;
+    std::unordered_set<TileData*> seen;
+    for (const auto& tilePtr : tilePtrs) {
+        if (seen.insert(tilePtr->data.get()).second) {
+            placing.push_back(tilePtr->data.get());
+        }
+    }
+
+    if (!parameters.data.getCrossTilePlacement() || parameters.mode != MapMode::Continuous) {
+        for (auto data : placing) {
+            data->redoPlacement(config, {}, callback);
+        }
+        return;
+    }
+
+    // Tiles are placed in four phases, by the parity of their x and y coordinates: first the
+    // tiles with even x and y, then those with odd x and even y, then those with even x and odd
+    // y, and finally those with odd x and y. Any two tiles that share an edge or a corner are in
+    // different phases. Each tile is placed around the labels that its neighbours of earlier
+    // phases placed near the shared edges and corners, once those neighbours have been placed
+    // for the current configuration. So no two labels overlap across an edge or corner, and
+    // every tile is still placed only once per configuration.
+    auto phase = [] (const TileID& tileID) {
+        return (tileID.x & 1) + 2 * (tileID.y & 1);
+    };
+
+    for (auto data : placing) {
+        const TileID& tileID = data->id;
+        if (phase(tileID) == 0) {
+            data->redoPlacement(config, {}, callback);
+            continue;
+        }
+
+        const std::array<TileID, 8> neighbourIDs = {{
+            TileID(tileID.z, tileID.x - 1, tileID.y, tileID.sourceZ),
+            TileID(tileID.z, tileID.x + 1, tileID.y, tileID.sourceZ),
+            TileID(tileID.z, tileID.x, tileID.y - 1, tileID.sourceZ),
+            TileID(tileID.z, tileID.x, tileID.y + 1, tileID.sourceZ),
+            TileID(tileID.z, tileID.x - 1, tileID.y - 1, tileID.sourceZ),
+            TileID(tileID.z, tileID.x + 1, tileID.y - 1, tileID.sourceZ),
+            TileID(tileID.z, tileID.x - 1, tileID.y + 1, tileID.sourceZ),
+            TileID(tileID.z, tileID.x + 1, tileID.y + 1, tileID.sourceZ),
+        }};
+
+        NeighbourBoxes neighbours;
+        bool neighboursPlaced = true;
+        for (std::size_t i = 0; i < neighbourIDs.size(); i++) {
+            const TileID neighbourID = neighbourIDs[i].normalized();
+            if (neighbourID.y < 0 || neighbourID.y >= (1 << neighbourID.z) ||
+                phase(neighbourID) >= phase(tileID)) {
+                continue;
+            }
+
+            auto it = tileDataMap.find(neighbourID);
+            const util::ptr<TileData> neighbour = it != tileDataMap.end() ? it->second.lock() : nullptr;
+            if (!neighbour || neighbour.get() == data || seen.find(neighbour.get()) == seen.end()) {
+                continue;
+            }
+
+            neighbours[i] = neighbour->getBorderBoxes();
+            if (!neighbours[i] && neighbour->getState() == TileData::State::parsed) {
+                // The neighbour is still being placed; it triggers another update when done.
+                neighboursPlaced = false;
+            }
+        }
+
+        if (neighboursPlaced) {
+            data->redoPlacement(config, neighbours, callback);
+        }
+    }
+}
+
 void Source::updateTilePtrs() {
     tilePtrs.clear();
     for (const auto& pair : tiles) {
@@ -471,14 +743,6 @@ void Source::updateTilePtrs() {
     }
 }
 
-void Source::setCacheSize(size_t size) {
-    cache.setSize(size);
-}
-
-void Source::onLowMemory() {
-    cache.clear();
-}
-
 void Source::setObserver(Observer* observer_) {
     observer = observer_;
 }
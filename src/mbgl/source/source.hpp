@@ -2,15 +2,18 @@
 #define MBGL_MAP_SOURCE
 
 #include <mbgl/tile/tile_data.hpp>
-#include <mbgl/tile/tile_cache.hpp>
+#include <mbgl/map/transform_state.hpp>
 #include <mbgl/source/source_info.hpp>
 
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/optional.hpp>
 
 #include <forward_list>
 #include <vector>
 #include <map>
+#include <unordered_set>
+#include <unordered_map>
 
 namespace mapbox {
 namespace geojsonvt {
@@ -70,9 +73,6 @@ public:
     std::forward_list<Tile *> getLoadedTiles() const;
     const std::vector<Tile*>& getTiles() const;
 
-    void setCacheSize(size_t);
-    void onLowMemory();
-
     void setObserver(Observer* observer);
     void dumpDebugLogs() const;
 
@@ -87,11 +87,19 @@ private:
                              std::exception_ptr,
                              bool isNewTile);
     bool handlePartialTile(const TileID&);
-    bool findLoadedChildren(const TileID&, int32_t maxCoveringZoom, std::vector<TileID>& retain);
-    void findLoadedParent(const TileID&, int32_t minCoveringZoom, std::vector<TileID>& retain);
+    bool findLoadedChildren(const TileID&, int32_t maxCoveringZoom, std::unordered_set<TileID>& retain);
+    void findLoadedParent(const TileID&, int32_t minCoveringZoom, std::unordered_set<TileID>& retain,
+                          const StyleUpdateParameters&);
+
+    std::vector<TileID> coveringTileIDs(const TransformState&) const;
+    void updatePrefetchedTiles(const StyleUpdateParameters&);
+    void updatePinnedParentTiles(const StyleUpdateParameters&);
+    void redoPlacement(const StyleUpdateParameters&);
 
     TileData::State addTile(const TileID&, const StyleUpdateParameters&);
+    std::shared_ptr<TileData> getTileData(const TileID& normalizedID, const StyleUpdateParameters&);
     TileData::State hasTile(const TileID&);
+    bool hasTilesAtZoom(int32_t z) const;
     void updateTilePtrs();
 
 private:
@@ -105,7 +113,30 @@ private:
     std::map<TileID, std::unique_ptr<Tile>> tiles;
     std::vector<Tile*> tilePtrs;
     std::map<TileID, std::weak_ptr<TileData>> tileDataMap;
-    TileCache cache;
+
+    // Number of tiles in `tiles` per zoom level. Levels without tiles are skipped when looking
+    // for loaded parents and children of missing tiles.
+    std::vector<uint32_t> zoomTileCounts;
+
+    // The tiles that covered the viewport in the last update, and the view they were computed
+    // for. They are reused as long as the view doesn't change, e.g. while tiles are loading.
+    optional<TransformState> coverState;
+    std::vector<TileID> coveringTiles;
+
+    // Tiles loaded ahead of time along the current camera animation, in the order in which they
+    // should be loaded. They are kept until the animation ends or is interrupted.
+    std::shared_ptr<const TransformPath> transitionPath;
+    std::vector<std::shared_ptr<TileData>> prefetchedTiles;
+    static const std::size_t maxPrefetchedTiles = 128;
+
+    // Ancestors of the tiles in view that are kept loaded as a fallback while zooming in, keyed
+    // by their normalized ID. Unlike the TileCache, they are never evicted while in use.
+    std::unordered_map<TileID, std::shared_ptr<TileData>> pinnedParentTiles;
+    bool pinningParentTiles = false;
+
+    // Set when the tiles of this source changed, so that the tiles it added to the shared
+    // TileCache are removed on the next update.
+    bool cacheInvalidated = false;
 
     std::unique_ptr<FileRequest> req;
 
@@ -125,4 +125,29 @@ FilterExpression parseFilterExpression(const JSValue& value) {
     }
 }
 
+struct FilterKeyVisitor : public mapbox::util::static_visitor<void> {
+    const std::function<void (const std::string&)>& function;
+
+    FilterKeyVisitor(const std::function<void (const std::string&)>& function_)
+        : function(function_) {}
+
+    template <class E>
+    void operator()(const E& e) const { function(e.key); }
+
+    void operator()(const NullExpression&) const {}
+    void operator()(const AnyExpression& e) const { visit(e.expressions); }
+    void operator()(const AllExpression& e) const { visit(e.expressions); }
+    void operator()(const NoneExpression& e) const { visit(e.expressions); }
+
+    void visit(const std::vector<FilterExpression>& expressions) const {
+        for (const auto& e : expressions) {
+            mapbox::util::apply_visitor(*this, e);
+        }
+    }
+};
+
+void eachFilterKey(const FilterExpression& expression, const std::function<void (const std::string&)>& function) {
+    mapbox::util::apply_visitor(FilterKeyVisitor(function), expression);
+}
+
 } // namespace mbgl
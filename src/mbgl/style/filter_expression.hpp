@@ -6,6 +6,7 @@
 
 #include <string>
 #include <vector>
+#include <functional>
 
 namespace mbgl {
 
@@ -26,6 +27,10 @@ typedef mapbox::util::variant<
 
 FilterExpression parseFilterExpression(const JSValue&);
 
+// Calls the function with every property key the expression refers to. The references stay valid
+// for as long as the expression is alive.
+void eachFilterKey(const FilterExpression&, const std::function<void (const std::string&)>&);
+
 template <class Extractor>
 bool evaluate(const FilterExpression&, const Extractor&);
 
@@ -2,6 +2,7 @@
 #include <mbgl/map/map_data.hpp>
 #include <mbgl/source/source.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/tile/tile_cancellation.hpp>
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/layer/symbol_layer.hpp>
 #include <mbgl/layer/custom_layer.hpp>
@@ -18,6 +19,8 @@
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/thread_context.hpp>
+#include <mbgl/util/simplify.hpp>
 #include <mbgl/platform/log.hpp>
 #include <mbgl/layer/background_layer.hpp>
 
@@ -27,6 +30,82 @@
 
 namespace mbgl {
 
+namespace {
+
+bool isPaintProperty(const JSValue& name) {
+    const std::string key { name.GetString(), name.GetStringLength() };
+    return key == "paint" || key.compare(0, 6, "paint.") == 0;
+}
+
+// Compares two layers, ignoring their paint properties and those of their classes.
+bool equalLayout(const JSValue& a, const JSValue& b) {
+    if (!a.IsObject() || !b.IsObject()) {
+        return a == b;
+    }
+
+    int32_t count = 0;
+    for (auto it = a.MemberBegin(); it != a.MemberEnd(); ++it) {
+        if (isPaintProperty(it->name)) {
+            continue;
+        }
+        auto other = b.FindMember(it->name);
+        if (other == b.MemberEnd() || !(other->value == it->value)) {
+            return false;
+        }
+        count++;
+    }
+
+    for (auto it = b.MemberBegin(); it != b.MemberEnd(); ++it) {
+        if (!isPaintProperty(it->name)) {
+            count--;
+        }
+    }
+
+    return count == 0;
+}
+
+// Returns true if the two styles only differ in paint properties, which are evaluated at render
+// time and don't affect the contents of the buckets.
+bool onlyPaintDiffers(const JSValue& a, const JSValue& b) {
+    if (!a.IsObject() || !b.IsObject()) {
+        return false;
+    }
+
+    int32_t count = 0;
+    for (auto it = a.MemberBegin(); it != a.MemberEnd(); ++it, ++count) {
+        auto other = b.FindMember(it->name);
+        if (other == b.MemberEnd()) {
+            return false;
+        }
+
+        if (std::string { it->name.GetString(), it->name.GetStringLength() } != "layers") {
+            if (!(other->value == it->value)) {
+                return false;
+            }
+            continue;
+        }
+
+        const JSValue& layersA = it->value;
+        const JSValue& layersB = other->value;
+        if (!layersA.IsArray() || !layersB.IsArray() || layersA.Size() != layersB.Size()) {
+            return false;
+        }
+        for (rapidjson::SizeType i = 0; i < layersA.Size(); ++i) {
+            if (!equalLayout(layersA[i], layersB[i])) {
+                return false;
+            }
+        }
+    }
+
+    for (auto it = b.MemberBegin(); it != b.MemberEnd(); ++it) {
+        count--;
+    }
+
+    return count == 0;
+}
+
+} // namespace
+
 Style::Style(MapData& data_, FileSource& fileSource_)
     : data(data_),
       fileSource(fileSource_),
@@ -35,7 +114,7 @@ Style::Style(MapData& data_, FileSource& fileSource_)
       spriteStore(std::make_unique<SpriteStore>(data.pixelRatio)),
       spriteAtlas(std::make_unique<SpriteAtlas>(1024, 1024, data.pixelRatio, *spriteStore)),
       lineAtlas(std::make_unique<LineAtlas>(512, 512)),
-      workers(4) {
+      workers(data.workerPool) {
     glyphStore->setObserver(this);
     spriteStore->setObserver(this);
 }
@@ -61,11 +140,59 @@ void Style::setJSON(const std::string& json, const std::string&) {
     loaded = true;
 }
 
+bool Style::setPaintJSON(const std::string& json, const std::string& previous) {
+    if (!loaded) {
+        return false;
+    }
+
+    JSDocument document;
+    document.Parse<0>(json.c_str());
+    JSDocument previousDocument;
+    previousDocument.Parse<0>(previous.c_str());
+
+    if (document.HasParseError() || previousDocument.HasParseError() ||
+        !onlyPaintDiffers(document, previousDocument)) {
+        return false;
+    }
+
+    StyleParser parser;
+    parser.parse(json);
+
+    // Replace the layers in place, so that layers that were added at runtime, like those of
+    // annotations, keep their position.
+    std::vector<std::vector<std::unique_ptr<StyleLayer>>::iterator> positions;
+    for (const auto& layer : parser.layers) {
+        auto it = std::find_if(layers.begin(), layers.end(), [&](const auto& existing) {
+            return existing->id == layer->id;
+        });
+        if (it == layers.end()) {
+            return false;
+        }
+        positions.push_back(it);
+    }
+
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        auto& layer = parser.layers[i];
+        if (SymbolLayer* symbolLayer = layer->as<SymbolLayer>()) {
+            symbolLayer->spriteAtlas = spriteAtlas.get();
+        }
+        *positions[i] = std::move(layer);
+    }
+
+    return true;
+}
+
 Style::~Style() {
     for (const auto& source : sources) {
         source->setObserver(nullptr);
     }
 
+    // The worker pool may be shared with other maps and keep running after this Style is
+    // gone. Releasing the sources and cached tiles cancels their pending work while the rest
+    // of the Style, which that work refers to, is still alive.
+    sources.clear();
+    tileCache.clear();
+
     glyphStore->setObserver(nullptr);
     spriteStore->setObserver(nullptr);
 }
@@ -117,15 +244,18 @@ void Style::removeLayer(const std::string& id) {
 }
 
 void Style::update(const TransformState& transform,
+                   std::shared_ptr<const TransformPath> transitionPath,
                    gl::TexturePool& texturePool) {
     bool allTilesUpdated = true;
     StyleUpdateParameters parameters(data.pixelRatio,
                                      data.getDebug(),
                                      data.getAnimationTime(),
                                      transform,
+                                     std::move(transitionPath),
                                      workers,
                                      fileSource,
                                      texturePool,
+                                     tileCache,
                                      shouldReparsePartialTiles,
                                      data.mode,
                                      data,
@@ -289,16 +419,12 @@ RenderData Style::getRenderData() const {
     return result;
 }
 
-void Style::setSourceTileCacheSize(size_t size) {
-    for (const auto& source : sources) {
-        source->setCacheSize(size);
-    }
+void Style::setTileCacheSize(uint64_t size) {
+    tileCache.setSize(size);
 }
 
 void Style::onLowMemory() {
-    for (const auto& source : sources) {
-        source->onLowMemory();
-    }
+    tileCache.clear();
 }
 
 void Style::setObserver(Observer* observer_) {
@@ -373,6 +499,16 @@ void Style::dumpDebugLogs() const {
     }
 
     spriteStore->dumpDebugLogs();
+
+    const auto cancelled = TileCancellation::getStats();
+    Log::Info(Event::General, "TileCancellation: skipped %llu features, %llu symbols",
+              static_cast<unsigned long long>(cancelled.features),
+              static_cast<unsigned long long>(cancelled.symbols));
+
+    const auto simplified = util::Simplifier::getStats();
+    Log::Info(Event::General, "Simplifier: removed %llu of %llu vertices",
+              static_cast<unsigned long long>(simplified.removedVertices),
+              static_cast<unsigned long long>(simplified.vertices));
 }
 
 } // namespace mbgl
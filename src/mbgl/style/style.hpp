@@ -4,6 +4,7 @@
 #include <mbgl/style/zoom_history.hpp>
 
 #include <mbgl/source/source.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/text/glyph_store.hpp>
 #include <mbgl/sprite/sprite_store.hpp>
 
@@ -74,13 +75,19 @@ public:
 
     void setJSON(const std::string& data, const std::string& base);
 
+    // Applies a style that differs from the current one, given as `previous`, in paint
+    // properties only. The layers are replaced, while the sources keep their tiles and the
+    // buckets in them. Returns false without changing anything if the styles differ in any
+    // other way, in which case the new style must be loaded with setJSON().
+    bool setPaintJSON(const std::string& data, const std::string& previous);
+
     void setObserver(Observer*);
 
     bool isLoaded() const;
 
     // Fetch the tiles needed by the current viewport and emit a signal when
     // a tile is ready so observers can render the tile.
-    void update(const TransformState&, gl::TexturePool&);
+    void update(const TransformState&, std::shared_ptr<const TransformPath>, gl::TexturePool&);
 
     void cascade();
     void recalculate(float z);
@@ -102,7 +109,9 @@ public:
 
     RenderData getRenderData() const;
 
-    void setSourceTileCacheSize(size_t);
+    // Limits the memory used by the tiles that all sources keep around after they went out
+    // of view, in bytes.
+    void setTileCacheSize(uint64_t);
     void onLowMemory();
 
     void dumpDebugLogs() const;
@@ -118,6 +127,7 @@ public:
 private:
     std::vector<std::unique_ptr<Source>> sources;
     std::vector<std::unique_ptr<StyleLayer>> layers;
+    TileCache tileCache;
 
     std::vector<std::unique_ptr<StyleLayer>>::const_iterator findLayer(const std::string& layerID) const;
 
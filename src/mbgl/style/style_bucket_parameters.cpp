@@ -5,15 +5,19 @@ namespace mbgl {
 
 void StyleBucketParameters::eachFilteredFeature(const FilterExpression& filter,
                                                 std::function<void (const GeometryTileFeature&)> function) {
-    for (std::size_t i = 0; !cancelled() && i < layer.featureCount(); i++) {
-        auto feature = layer.getFeature(i);
+    GeometryTileLayerKeys keys(layer);
+    keys.add(filter);
 
-        GeometryTileFeatureExtractor extractor(*feature);
+    const std::size_t visited = layer.eachFeature([&] (const GeometryTileFeature& feature) {
+        GeometryTileFeatureExtractor extractor(feature, &keys);
         if (!evaluate(filter, extractor))
-            continue;
+            return;
 
-        function(*feature);
-    }
+        function(feature);
+    }, [&] {
+        return cancelled();
+    });
+    cancellation.skippedFeatures(layer.featureCount() - visited);
 }
 
 } // namespace mbgl
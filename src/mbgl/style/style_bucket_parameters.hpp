@@ -3,7 +3,7 @@
 
 #include <mbgl/map/mode.hpp>
 #include <mbgl/style/filter_expression.hpp>
-#include <mbgl/tile/tile_data.hpp>
+#include <mbgl/tile/tile_cancellation.hpp>
 
 #include <functional>
 
@@ -21,38 +21,43 @@ class StyleBucketParameters {
 public:
     StyleBucketParameters(const TileID& tileID_,
                           const GeometryTileLayer& layer_,
-                          const std::atomic<TileData::State>& state_,
+                          const TileCancellation& cancellation_,
                           uintptr_t tileUID_,
                           bool& partialParse_,
                           SpriteStore& spriteStore_,
                           GlyphAtlas& glyphAtlas_,
                           GlyphStore& glyphStore_,
-                          const MapMode mode_)
+                          const MapMode mode_,
+                          float simplificationTolerance_)
         : tileID(tileID_),
           layer(layer_),
-          state(state_),
+          cancellation(cancellation_),
           tileUID(tileUID_),
           partialParse(partialParse_),
           spriteStore(spriteStore_),
           glyphAtlas(glyphAtlas_),
           glyphStore(glyphStore_),
-          mode(mode_) {}
+          mode(mode_),
+          simplificationTolerance(simplificationTolerance_) {}
 
     bool cancelled() const {
-        return state == TileData::State::obsolete;
+        return cancellation.cancelled();
     }
 
     void eachFilteredFeature(const FilterExpression&, std::function<void (const GeometryTileFeature&)>);
 
     const TileID& tileID;
     const GeometryTileLayer& layer;
-    const std::atomic<TileData::State>& state;
+    const TileCancellation& cancellation;
     uintptr_t tileUID;
     bool& partialParse;
     SpriteStore& spriteStore;
     GlyphAtlas& glyphAtlas;
     GlyphStore& glyphStore;
     const MapMode mode;
+
+    // Tolerance in pixels for simplifying lines and polygons, or 0 to keep all vertices.
+    const float simplificationTolerance;
 };
 
 } // namespace mbgl
@@ -2,14 +2,17 @@
 #define STYLE_UPDATE_PARAMETERS
 
 #include <mbgl/map/mode.hpp>
+#include <mbgl/map/transform_state.hpp>
+
+#include <memory>
 
 namespace mbgl {
 
-class TransformState;
 class Worker;
 class FileSource;
 class MapData;
 class Style;
+class TileCache;
 namespace gl { class TexturePool; }
 
 class StyleUpdateParameters {
@@ -18,9 +21,11 @@ public:
                           MapDebugOptions debugOptions_,
                           TimePoint animationTime_,
                           const TransformState& transformState_,
+                          std::shared_ptr<const TransformPath> transitionPath_,
                           Worker& worker_,
                           FileSource& fileSource_,
                           gl::TexturePool& texturePool_,
+                          TileCache& tileCache_,
                           bool shouldReparsePartialTiles_,
                           const MapMode mode_,
                           MapData& data_,
@@ -29,9 +34,11 @@ public:
           debugOptions(debugOptions_),
           animationTime(animationTime_),
           transformState(transformState_),
+          transitionPath(std::move(transitionPath_)),
           worker(worker_),
           fileSource(fileSource_),
           texturePool(texturePool_),
+          tileCache(tileCache_),
           shouldReparsePartialTiles(shouldReparsePartialTiles_),
           mode(mode_),
           data(data_),
@@ -41,9 +48,14 @@ public:
     MapDebugOptions debugOptions;
     TimePoint animationTime;
     const TransformState& transformState;
+
+    // Set while the camera is animating and tiles along the animation should be prefetched.
+    std::shared_ptr<const TransformPath> transitionPath;
+
     Worker& worker;
     FileSource& fileSource;
     gl::TexturePool& texturePool;
+    TileCache& tileCache;
     bool shouldReparsePartialTiles;
     const MapMode mode;
 
@@ -4,6 +4,8 @@
 #include <mbgl/util/vec.hpp>
 #include <mbgl/geometry/anchor.hpp>
 #include <mbgl/text/shaping.hpp>
+#include <array>
+#include <memory>
 #include <vector>
 
 namespace mbgl {
@@ -57,6 +59,14 @@ namespace mbgl {
         private:
             void bboxifyLabel(const std::vector<Coordinate> &line, Coordinate &anchorPoint, const int segment, const float length, const float height);
     };
+
+    // The boxes of the labels a tile placed close enough to its edges to collide with the labels
+    // of its neighbours.
+    using BorderBoxes = std::vector<CollisionBox>;
+
+    // The border boxes of the tiles to the left, right, top and bottom of a tile, followed by
+    // those of the tiles to the top left, top right, bottom left and bottom right.
+    using NeighbourBoxes = std::array<std::shared_ptr<const BorderBoxes>, 8>;
 } // namespace mbgl
 
 #endif
@@ -82,7 +82,7 @@ float CollisionTile::placeFeature(const CollisionFeature &feature, const bool al
         const auto anchor = box.anchor.matMul(rotationMatrix);
 
         if (!allowOverlap) {
-            std::vector<CollisionTreeBox> blockingBoxes;
+            blockingBoxes.clear();
             tree.query(bgi::intersects(getTreeBox(anchor, box)), std::back_inserter(blockingBoxes));
 
             for (auto& blockingTreeBox : blockingBoxes) {
@@ -121,19 +121,63 @@ float CollisionTile::placeFeature(const CollisionFeature &feature, const bool al
     return minPlacementScale;
 }
 
+void CollisionTile::insertNeighbourBoxes(const NeighbourBoxes& neighbours) {
+    const std::array<vec2<float>, 8> offsets = {{
+        // left
+        vec2<float>(-util::EXTENT, 0),
+        // right
+        vec2<float>(util::EXTENT, 0),
+        // top
+        vec2<float>(0, -util::EXTENT),
+        // bottom
+        vec2<float>(0, util::EXTENT),
+        // top left
+        vec2<float>(-util::EXTENT, -util::EXTENT),
+        // top right
+        vec2<float>(util::EXTENT, -util::EXTENT),
+        // bottom left
+        vec2<float>(-util::EXTENT, util::EXTENT),
+        // bottom right
+        vec2<float>(util::EXTENT, util::EXTENT),
+    }};
+
+    treeBoxes.clear();
+    for (std::size_t i = 0; i < neighbours.size(); i++) {
+        if (!neighbours[i]) {
+            continue;
+        }
+        for (auto box : *neighbours[i]) {
+            box.anchor = box.anchor + offsets[i];
+            treeBoxes.emplace_back(getTreeBox(box.anchor.matMul(rotationMatrix), box), box);
+        }
+    }
+    tree.insert(treeBoxes.begin(), treeBoxes.end());
+}
+
 void CollisionTile::insertFeature(CollisionFeature &feature, const float minPlacementScale) {
     for (auto& box : feature.boxes) {
         box.placementScale = minPlacementScale;
     }
 
     if (minPlacementScale < maxScale) {
-        std::vector<CollisionTreeBox> treeBoxes;
+        treeBoxes.clear();
         for (auto& box : feature.boxes) {
             treeBoxes.emplace_back(getTreeBox(box.anchor.matMul(rotationMatrix), box), box);
         }
         tree.insert(treeBoxes.begin(), treeBoxes.end());
-    }
 
+        // A box is largest at the scale the label is first shown at, and may extend in any
+        // direction once rotated back into tile coordinates.
+        for (auto& box : feature.boxes) {
+            const float reach = std::sqrt(2.0f) / minPlacementScale *
+                ::fmax(::fmax(std::abs(box.x1), std::abs(box.x2)),
+                       ::fmax(std::abs(box.y1), std::abs(box.y2)) * yStretch);
+            if (box.anchor.x < reach || box.anchor.x > util::EXTENT - reach ||
+                box.anchor.y < reach || box.anchor.y > util::EXTENT - reach) {
+                borderBoxes.push_back(box);
+            }
+        }
+    }
 }
 
 Box CollisionTile::getTreeBox(const vec2<float> &anchor, const CollisionBox &box) {
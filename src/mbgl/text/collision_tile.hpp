@@ -37,9 +37,16 @@ class CollisionTile {
 public:
     explicit CollisionTile(PlacementConfig);
 
+    // Inserts the labels the neighbouring tiles placed along the shared edges and corners, so
+    // that the labels of this tile are placed around them.
+    void insertNeighbourBoxes(const NeighbourBoxes&);
+
     float placeFeature(const CollisionFeature& feature, const bool allowOverlap, const bool avoidEdges);
     void insertFeature(CollisionFeature& feature, const float minPlacementScale);
 
+    // The boxes of the inserted labels that may reach past the edges of the tile.
+    const BorderBoxes& getBorderBoxes() const { return borderBoxes; }
+
     const PlacementConfig config;
 
     const float minScale = 0.5f;
@@ -53,6 +60,13 @@ private:
     Box getTreeBox(const vec2<float>& anchor, const CollisionBox& box);
 
     Tree tree;
+
+    // Reused across calls so that placing a tile doesn't allocate for every box it queries.
+    std::vector<CollisionTreeBox> blockingBoxes;
+    std::vector<CollisionTreeBox> treeBoxes;
+
+    BorderBoxes borderBoxes;
+
     std::array<float, 4> rotationMatrix;
     std::array<float, 4> reverseRotationMatrix;
     std::array<CollisionBox, 4> edges;
@@ -1,12 +1,14 @@
 #ifndef MBGL_TEXT_PLACEMENT_CONFIG
 #define MBGL_TEXT_PLACEMENT_CONFIG
 
+#include <cmath>
+
 namespace mbgl {
 
 class PlacementConfig {
 public:
-    inline PlacementConfig(float angle_ = 0, float pitch_ = 0, bool debug_ = false)
-        : angle(angle_), pitch(pitch_), debug(debug_) {
+    inline PlacementConfig(float angle_ = 0, float pitch_ = 0, bool debug_ = false, bool moving_ = false)
+        : angle(angle_), pitch(pitch_), debug(debug_), moving(moving_) {
     }
 
     inline bool operator==(const PlacementConfig& rhs) const {
@@ -17,10 +19,34 @@ public:
         return !operator==(rhs);
     }
 
+    // Returns whether labels placed for the other configuration can be shown for this one. While
+    // the camera is moving, small rotations and tilts don't move labels far enough to make them
+    // visibly collide, so tiles are placed again only once the map has turned further than this
+    // from their last placement. Once the camera has settled, labels are placed for its exact
+    // angle and pitch.
+    inline bool isEquivalent(const PlacementConfig& rhs) const {
+        if (debug != rhs.debug) {
+            return false;
+        }
+        if (!moving) {
+            return angle == rhs.angle && pitch == rhs.pitch;
+        }
+        const float angleDelta = std::fmod(std::abs(angle - rhs.angle), float(2 * M_PI));
+        return std::fmin(angleDelta, float(2 * M_PI) - angleDelta) <= angleThreshold &&
+               std::abs(pitch - rhs.pitch) <= pitchThreshold;
+    }
+
+    static constexpr float angleThreshold = M_PI / 90; // 2°
+    static constexpr float pitchThreshold = M_PI / 180; // 1°
+
 public:
     float angle;
     float pitch;
     bool debug;
+
+    // Whether the camera is being rotated or tilted, see TransformState::isRotating() and
+    // TransformState::isGestureInProgress().
+    bool moving;
 };
 
 } // namespace mbgl
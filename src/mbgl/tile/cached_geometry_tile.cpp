@@ -0,0 +1,161 @@
+#include <mbgl/tile/cached_geometry_tile.hpp>
+
+#include <stdexcept>
+
+namespace mbgl {
+
+CachedGeometryTileFeature::CachedGeometryTileFeature(const CachedGeometryTileLayer& layer_, std::size_t index_)
+    : layer(layer_), index(index_) {
+}
+
+FeatureType CachedGeometryTileFeature::getType() const {
+    return layer.types[index];
+}
+
+optional<Value> CachedGeometryTileFeature::getValue(const std::string& key) const {
+    return getIndexedValue(*layer.getKeyIndex(key));
+}
+
+optional<Value> CachedGeometryTileFeature::getIndexedValue(uint32_t key) const {
+    return layer.decodeValues(key)[index];
+}
+
+GeometryCollection CachedGeometryTileFeature::getGeometries() const {
+    GeometryCollection lines;
+    GeometryCollectionBuilder builder(lines);
+    visitGeometries(builder);
+
+    if (lines.empty()) {
+        lines.emplace_back();
+    }
+
+    return lines;
+}
+
+void CachedGeometryTileFeature::visitGeometries(GeometryVisitor& visitor) const {
+    layer.decodeGeometries();
+
+    const auto& lines = layer.lines;
+    const auto& coordinates = layer.coordinates;
+    for (uint32_t line = layer.featureLines[index]; line < layer.featureLines[index + 1]; line++) {
+        visitor.beginLine();
+        for (uint32_t i = lines[line]; i < lines[line + 1]; i++) {
+            visitor.addPoint(coordinates[i]);
+        }
+        visitor.endLine();
+    }
+}
+
+uint32_t CachedGeometryTileFeature::getExtent() const {
+    return layer.extents[index];
+}
+
+CachedGeometryTileLayer::CachedGeometryTileLayer(util::ptr<GeometryTileLayer> layer_)
+    : layer(std::move(layer_)) {
+    const std::size_t count = layer->featureCount();
+    types.reserve(count);
+    extents.reserve(count);
+    layer->eachFeature([&] (const GeometryTileFeature& feature) {
+        types.push_back(feature.getType());
+        extents.push_back(feature.getExtent());
+    });
+}
+
+void CachedGeometryTileLayer::decodeGeometries() const {
+    if (geometriesDecoded) {
+        return;
+    }
+    geometriesDecoded = true;
+
+    class Visitor : public GeometryVisitor {
+    public:
+        Visitor(const CachedGeometryTileLayer& layer_) : layer(layer_) {}
+
+        void beginLine() override {}
+
+        void addPoint(const Coordinate& point) override {
+            layer.coordinates.push_back(point);
+        }
+
+        void endLine() override {
+            layer.lines.push_back(layer.coordinates.size());
+        }
+
+    private:
+        const CachedGeometryTileLayer& layer;
+    } visitor(*this);
+
+    featureLines.reserve(featureCount() + 1);
+    layer->eachFeature([&] (const GeometryTileFeature& feature) {
+        feature.visitGeometries(visitor);
+        featureLines.push_back(lines.size() - 1);
+    });
+}
+
+optional<uint32_t> CachedGeometryTileLayer::getKeyIndex(const std::string& key) const {
+    auto it = keys.find(key);
+    if (it == keys.end()) {
+        it = keys.emplace(key, keyNames.size()).first;
+        keyNames.push_back(&it->first);
+        values.emplace_back();
+        valuesDecoded.push_back(false);
+    }
+    return it->second;
+}
+
+const std::vector<optional<Value>>& CachedGeometryTileLayer::decodeValues(uint32_t key) const {
+    if (key >= values.size()) {
+        throw std::out_of_range("key index out of range");
+    }
+
+    auto& column = values[key];
+    if (!valuesDecoded[key]) {
+        valuesDecoded[key] = true;
+
+        const std::string& name = *keyNames[key];
+        const optional<uint32_t> sourceKey = layer->getKeyIndex(name);
+
+        column.reserve(featureCount());
+        layer->eachFeature([&] (const GeometryTileFeature& feature) {
+            column.push_back(sourceKey ? feature.getIndexedValue(*sourceKey) : feature.getValue(name));
+        });
+    }
+    return column;
+}
+
+util::ptr<const GeometryTileFeature> CachedGeometryTileLayer::getFeature(std::size_t i) const {
+    if (i >= featureCount()) {
+        throw std::out_of_range("feature index out of range");
+    }
+    return std::make_shared<CachedGeometryTileFeature>(*this, i);
+}
+
+std::size_t CachedGeometryTileLayer::eachFeature(const std::function<void (const GeometryTileFeature&)>& function,
+                                                 const std::function<bool ()>& stop) const {
+    const std::size_t count = featureCount();
+    for (std::size_t i = 0; i < count; i++) {
+        if (stop && stop()) {
+            return i;
+        }
+        function(CachedGeometryTileFeature(*this, i));
+    }
+    return count;
+}
+
+CachedGeometryTile::CachedGeometryTile(const GeometryTile& tile_)
+    : tile(tile_) {
+}
+
+util::ptr<GeometryTileLayer> CachedGeometryTile::getLayer(const std::string& name) const {
+    auto it = layers.find(name);
+    if (it == layers.end()) {
+        util::ptr<GeometryTileLayer> layer = tile.getLayer(name);
+        if (layer) {
+            layer = std::make_shared<CachedGeometryTileLayer>(std::move(layer));
+        }
+        it = layers.emplace(name, std::move(layer)).first;
+    }
+    return it->second;
+}
+
+} // namespace mbgl
@@ -0,0 +1,85 @@
+#ifndef MBGL_MAP_CACHED_GEOMETRY_TILE
+#define MBGL_MAP_CACHED_GEOMETRY_TILE
+
+#include <mbgl/tile/geometry_tile.hpp>
+
+#include <unordered_map>
+
+namespace mbgl {
+
+class CachedGeometryTileLayer;
+
+// A lightweight view onto a single feature of a CachedGeometryTileLayer. Like VectorTileFeature,
+// it doesn't own any data and is constructed on the stack for every feature that gets visited.
+class CachedGeometryTileFeature : public GeometryTileFeature {
+public:
+    CachedGeometryTileFeature(const CachedGeometryTileLayer&, std::size_t index);
+
+    FeatureType getType() const override;
+    optional<Value> getValue(const std::string&) const override;
+    optional<Value> getIndexedValue(uint32_t key) const override;
+    GeometryCollection getGeometries() const override;
+    void visitGeometries(GeometryVisitor&) const override;
+    uint32_t getExtent() const override;
+
+private:
+    const CachedGeometryTileLayer& layer;
+    const std::size_t index;
+};
+
+// Decodes the features of a source layer into flat columns. The geometries of all features are
+// decoded in one pass the first time any feature's geometry is visited. Property values are
+// decoded one key at a time, for all features, the first time a feature is asked for that key.
+class CachedGeometryTileLayer : public GeometryTileLayer {
+public:
+    CachedGeometryTileLayer(util::ptr<GeometryTileLayer>);
+
+    std::size_t featureCount() const override { return types.size(); }
+    util::ptr<const GeometryTileFeature> getFeature(std::size_t) const override;
+    std::size_t eachFeature(const std::function<void (const GeometryTileFeature&)>&,
+                            const std::function<bool ()>& stop = {}) const override;
+    optional<uint32_t> getKeyIndex(const std::string&) const override;
+
+private:
+    friend class CachedGeometryTileFeature;
+
+    void decodeGeometries() const;
+    const std::vector<optional<Value>>& decodeValues(uint32_t key) const;
+
+    const util::ptr<GeometryTileLayer> layer;
+
+    std::vector<FeatureType> types;
+    std::vector<uint32_t> extents;
+
+    // The lines of feature i are lines[featureLines[i]] up to lines[featureLines[i + 1]], and
+    // line j holds coordinates[lines[j]] up to coordinates[lines[j + 1]].
+    mutable bool geometriesDecoded = false;
+    mutable std::vector<Coordinate> coordinates;
+    mutable std::vector<uint32_t> lines { 0 };
+    mutable std::vector<uint32_t> featureLines { 0 };
+
+    // Keys are numbered in the order in which they are first requested. values[key][i] holds the
+    // value of feature i once the key has been decoded.
+    mutable std::unordered_map<std::string, uint32_t> keys;
+    mutable std::vector<const std::string*> keyNames;
+    mutable std::vector<std::vector<optional<Value>>> values;
+    mutable std::vector<bool> valuesDecoded;
+};
+
+// Decode cache for the duration of a single tile parse. Source layers are looked up and wrapped
+// once per name, and all style layers that reference the same source layer share the decoded
+// geometries and property values of its features.
+class CachedGeometryTile : public GeometryTile {
+public:
+    CachedGeometryTile(const GeometryTile&);
+
+    util::ptr<GeometryTileLayer> getLayer(const std::string&) const override;
+
+private:
+    const GeometryTile& tile;
+    mutable std::unordered_map<std::string, util::ptr<GeometryTileLayer>> layers;
+};
+
+} // namespace mbgl
+
+#endif
@@ -4,12 +4,75 @@
 
 namespace mbgl {
 
+void visitGeometryCollection(const GeometryCollection& geometries, GeometryVisitor& visitor) {
+    for (const auto& line : geometries) {
+        if (line.empty()) {
+            continue;
+        }
+        visitor.beginLine();
+        for (const auto& point : line) {
+            visitor.addPoint(point);
+        }
+        visitor.endLine();
+    }
+}
+
+void GeometryTileFeature::visitGeometries(GeometryVisitor& visitor) const {
+    visitGeometryCollection(getGeometries(), visitor);
+}
+
+std::size_t GeometryTileLayer::eachFeature(const std::function<void (const GeometryTileFeature&)>& function,
+                                           const std::function<bool ()>& stop) const {
+    const std::size_t count = featureCount();
+    for (std::size_t i = 0; i < count; i++) {
+        if (stop && stop()) {
+            return i;
+        }
+        function(*getFeature(i));
+    }
+    return count;
+}
+
+GeometryTileLayerKeys::GeometryTileLayerKeys(const GeometryTileLayer& layer_)
+    : layer(layer_) {
+}
+
+void GeometryTileLayerKeys::add(const std::string& key) {
+    if (key == "$type") {
+        return;
+    }
+
+    if (auto index = layer.getKeyIndex(key)) {
+        keys.push_back({ &key, key, *index });
+    }
+}
+
+void GeometryTileLayerKeys::add(const FilterExpression& filter) {
+    eachFilterKey(filter, [&] (const std::string& key) { add(key); });
+}
+
+optional<Value> GeometryTileLayerKeys::getValue(const GeometryTileFeature& feature, const std::string& key) const {
+    for (const auto& k : keys) {
+        if (k.source == &key) {
+            return feature.getIndexedValue(k.index);
+        }
+    }
+
+    for (const auto& k : keys) {
+        if (k.name == key) {
+            return feature.getIndexedValue(k.index);
+        }
+    }
+
+    return feature.getValue(key);
+}
+
 optional<Value> GeometryTileFeatureExtractor::getValue(const std::string& key) const {
     if (key == "$type") {
         return Value(uint64_t(feature.getType()));
     }
 
-    return feature.getValue(key);
+    return keys ? keys->getValue(feature, key) : feature.getValue(key);
 }
 
 template bool evaluate(const FilterExpression&, const GeometryTileFeatureExtractor&);
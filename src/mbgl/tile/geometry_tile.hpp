@@ -4,6 +4,7 @@
 #include <mapbox/variant.hpp>
 
 #include <mbgl/style/value.hpp>
+#include <mbgl/style/filter_expression.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/ptr.hpp>
 #include <mbgl/util/vec.hpp>
@@ -26,12 +27,46 @@ enum class FeatureType : uint8_t {
 
 typedef std::vector<std::vector<Coordinate>> GeometryCollection;
 
+// Receives a feature's geometry one line (or polygon ring) at a time. Lines are never empty.
+class GeometryVisitor {
+public:
+    virtual ~GeometryVisitor() = default;
+    virtual void beginLine() = 0;
+    virtual void addPoint(const Coordinate&) = 0;
+    virtual void endLine() = 0;
+};
+
+// Materializes the visited geometry into a GeometryCollection.
+class GeometryCollectionBuilder : public GeometryVisitor {
+public:
+    GeometryCollectionBuilder(GeometryCollection& geometries_) : geometries(geometries_) {}
+
+    void beginLine() override { geometries.emplace_back(); }
+    void addPoint(const Coordinate& point) override { geometries.back().push_back(point); }
+    void endLine() override {}
+
+private:
+    GeometryCollection& geometries;
+};
+
+void visitGeometryCollection(const GeometryCollection&, GeometryVisitor&);
+
 class GeometryTileFeature : private util::noncopyable {
 public:
     virtual ~GeometryTileFeature() = default;
     virtual FeatureType getType() const = 0;
     virtual optional<Value> getValue(const std::string& key) const = 0;
+
+    // Looks up a property by a key index obtained from GeometryTileLayer::getKeyIndex(). Only
+    // features of layers that intern their keys need to implement this.
+    virtual optional<Value> getIndexedValue(uint32_t) const { return {}; }
+
     virtual GeometryCollection getGeometries() const = 0;
+
+    // Pushes the geometry to the visitor without materializing a GeometryCollection. The default
+    // implementation walks the result of getGeometries().
+    virtual void visitGeometries(GeometryVisitor&) const;
+
     virtual uint32_t getExtent() const = 0;
 };
 
@@ -40,6 +75,18 @@ public:
     virtual ~GeometryTileLayer() = default;
     virtual std::size_t featureCount() const = 0;
     virtual util::ptr<const GeometryTileFeature> getFeature(std::size_t) const = 0;
+
+    // Resolves a property key to an index into this layer's key table, which features accept in
+    // getIndexedValue(). Layers without a key table return an empty optional; their features
+    // must be queried by name.
+    virtual optional<uint32_t> getKeyIndex(const std::string&) const { return {}; }
+
+    // Calls the function once for every feature in this layer, in order. Implementations may pass
+    // short-lived views onto their own storage, so the function must not retain the reference.
+    // If given, stop is checked before every feature and ends the iteration when it returns true.
+    // Returns the number of features visited.
+    virtual std::size_t eachFeature(const std::function<void (const GeometryTileFeature&)>&,
+                                    const std::function<bool ()>& stop = {}) const;
 };
 
 class GeometryTile : private util::noncopyable {
@@ -69,15 +116,41 @@ public:
     virtual std::unique_ptr<FileRequest> monitorTile(const Callback&) = 0;
 };
 
+// Resolves the property keys used while building a bucket against a layer's key table once, ahead
+// of the per-feature loop. Keys registered by reference (e.g. those owned by a filter) are matched
+// by address, so looking them up doesn't compare or hash any strings.
+class GeometryTileLayerKeys {
+public:
+    GeometryTileLayerKeys(const GeometryTileLayer&);
+
+    // The key must outlive this object.
+    void add(const std::string& key);
+    void add(const FilterExpression&);
+
+    optional<Value> getValue(const GeometryTileFeature&, const std::string& key) const;
+
+private:
+    struct Key {
+        const std::string* source;
+        std::string name;
+        uint32_t index;
+    };
+
+    const GeometryTileLayer& layer;
+    std::vector<Key> keys;
+};
+
 class GeometryTileFeatureExtractor {
 public:
-    GeometryTileFeatureExtractor(const GeometryTileFeature& feature_)
-        : feature(feature_) {}
+    GeometryTileFeatureExtractor(const GeometryTileFeature& feature_,
+                                 const GeometryTileLayerKeys* keys_ = nullptr)
+        : feature(feature_), keys(keys_) {}
 
     optional<Value> getValue(const std::string& key) const;
 
 private:
     const GeometryTileFeature& feature;
+    const GeometryTileLayerKeys* keys;
 };
 
 } // namespace mbgl
@@ -44,7 +44,7 @@ RasterTileData::RasterTileData(const TileID& id_,
             }
 
             workRequest.reset();
-            workRequest = worker.parseRasterTile(std::make_unique<RasterBucket>(texturePool), res.data, [this, callback] (RasterTileParseResult result) {
+            workRequest = worker.parseRasterTile(std::make_unique<RasterBucket>(texturePool), res.data, priority, [this, callback] (RasterTileParseResult result) {
                 workRequest.reset();
                 if (state != State::loaded) {
                     return;
@@ -74,6 +74,25 @@ Bucket* RasterTileData::getBucket(StyleLayer const&) {
     return bucket.get();
 }
 
+void RasterTileData::setPriority(int32_t priority_) {
+    if (priority == priority_) {
+        return;
+    }
+
+    priority = priority_;
+
+    if (req) {
+        req->setPriority(priority);
+    }
+    if (workRequest) {
+        workRequest->setPriority(priority);
+    }
+}
+
+std::size_t RasterTileData::getByteSize() const {
+    return bucket ? bucket->getByteSize() : 0;
+}
+
 void RasterTileData::cancel() {
     if (state != State::obsolete) {
         state = State::obsolete;
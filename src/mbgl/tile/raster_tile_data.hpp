@@ -26,6 +26,9 @@ public:
     void cancel() override;
     Bucket* getBucket(StyleLayer const &layer_desc) override;
 
+    void setPriority(int32_t) override;
+    std::size_t getByteSize() const override;
+
 private:
     gl::TexturePool& texturePool;
     Worker& worker;
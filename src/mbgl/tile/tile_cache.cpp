@@ -1,65 +1,101 @@
 #include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/tile/tile_data.hpp>
 
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
 #include <cassert>
 
 namespace mbgl {
 
-void TileCache::setSize(size_t size_) {
-    size = size_;
+namespace {
 
-    while (orderedKeys.size() > size) {
-        auto key = orderedKeys.front();
-        orderedKeys.pop_front();
-        tiles.erase(key);
-    }
+const std::size_t minimumTileSize = 4 * 1024;
 
-    assert(orderedKeys.size() <= size);
+} // namespace
 
-    tiles.reserve(size);
+std::size_t TileCache::KeyHash::operator()(const Key& key) const {
+    std::size_t seed = 0;
+    boost::hash_combine(seed, key.sourceID);
+    boost::hash_combine(seed, key.tileID);
+    return seed;
 }
 
-void TileCache::add(uint64_t key, std::shared_ptr<TileData> data) {
-
-    // insert new or query existing data
-    if (tiles.emplace(key, data).second) {
-        // remove existing data key
-        orderedKeys.remove(key);
-    }
-
-    // (re-)insert data key as newest
-    orderedKeys.push_back(key);
+void TileCache::setSize(uint64_t size_) {
+    size = size_;
+    evict();
+}
 
-    // purge oldest key/data if necessary
-    if (orderedKeys.size() > size) {
-        get(orderedKeys.front());
+void TileCache::add(const std::string& sourceID, uint64_t key, std::shared_ptr<TileData> data) {
+    assert(data);
+
+    // Tiles keep their GPU buffers while they are cached, so measure them as they are now.
+    // Tiles without any buckets still hold their parser state and requests, and must not be
+    // free, or a cache full of empty tiles would never be trimmed.
+    const std::size_t dataSize = std::max(data->getByteSize(), minimumTileSize);
+
+    auto it = index.find({ sourceID, key });
+    if (it != index.end()) {
+        // Replace the existing data and mark it as newest.
+        used -= it->second->size;
+        it->second->data = std::move(data);
+        it->second->size = dataSize;
+        entries.splice(entries.end(), entries, it->second);
+    } else {
+        entries.push_back({ { sourceID, key }, std::move(data), dataSize });
+        index.emplace(entries.back().key, std::prev(entries.end()));
     }
 
-    assert(orderedKeys.size() <= size);
-};
-
-std::shared_ptr<TileData> TileCache::get(uint64_t key) {
+    used += dataSize;
+    evict();
+}
 
+std::shared_ptr<TileData> TileCache::get(const std::string& sourceID, uint64_t key) {
     std::shared_ptr<TileData> data;
 
-    auto it = tiles.find(key);
-    if (it != tiles.end()) {
-        data = it->second;
-        tiles.erase(it);
-        orderedKeys.remove(key);
+    auto it = index.find({ sourceID, key });
+    if (it != index.end()) {
+        data = std::move(it->second->data);
+        erase(it->second);
         assert(data->isReady());
     }
 
     return data;
-};
+}
 
-bool TileCache::has(uint64_t key) {
-    return tiles.find(key) != tiles.end();
+bool TileCache::has(const std::string& sourceID, uint64_t key) const {
+    return index.find({ sourceID, key }) != index.end();
+}
+
+void TileCache::clear(const std::string& sourceID) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->key.sourceID == sourceID) {
+            erase(it++);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void TileCache::clear() {
-    orderedKeys.clear();
-    tiles.clear();
+    index.clear();
+    entries.clear();
+    used = 0;
+}
+
+void TileCache::erase(Entries::iterator it) {
+    used -= it->size;
+    index.erase(it->key);
+    entries.erase(it);
+}
+
+void TileCache::evict() {
+    while (used > size) {
+        assert(!entries.empty());
+        erase(entries.begin());
+    }
+
+    assert(entries.size() == index.size());
 }
 
 } // namespace mbgl
@@ -1,30 +1,74 @@
 #ifndef MBGL_MAP_TILE_CACHE
 #define MBGL_MAP_TILE_CACHE
 
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cstdint>
 #include <list>
 #include <memory>
+#include <string>
 #include <unordered_map>
 
 namespace mbgl {
 
 class TileData;
 
-class TileCache {
+// Keeps parsed tiles that are no longer visible around, so that they don't need to be loaded
+// and parsed again when they come back into view. All sources of a style share one cache, which
+// is limited by the number of bytes its tiles occupy rather than by their number, as the size
+// of a tile varies a lot with its content. Once the limit is exceeded, the least recently
+// added tiles are evicted.
+class TileCache : private util::noncopyable {
 public:
-    TileCache(size_t size_ = 0) : size(size_) {}
+    TileCache(uint64_t size_ = util::DEFAULT_TILE_CACHE_SIZE) : size(size_) {}
+
+    // Maximum number of bytes, see TileData::getByteSize().
+    void setSize(uint64_t);
+    uint64_t getSize() const { return size; };
+
+    // Number of bytes held by the tiles currently in the cache.
+    uint64_t getUsedSize() const { return used; }
 
-    void setSize(size_t);
-    size_t getSize() const { return size; };
-    void add(uint64_t key, std::shared_ptr<TileData> data);
-    std::shared_ptr<TileData> get(uint64_t key);
-    bool has(uint64_t key);
+    void add(const std::string& sourceID, uint64_t key, std::shared_ptr<TileData> data);
+    std::shared_ptr<TileData> get(const std::string& sourceID, uint64_t key);
+    bool has(const std::string& sourceID, uint64_t key) const;
+
+    // Removes the tiles of one source.
+    void clear(const std::string& sourceID);
     void clear();
 
 private:
-    std::unordered_map<uint64_t, std::shared_ptr<TileData>> tiles;
-    std::list<uint64_t> orderedKeys;
+    struct Key {
+        std::string sourceID;
+        uint64_t tileID;
+
+        bool operator==(const Key& rhs) const {
+            return tileID == rhs.tileID && sourceID == rhs.sourceID;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key&) const;
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<TileData> data;
+        std::size_t size;
+    };
+
+    using Entries = std::list<Entry>;
+
+    void erase(Entries::iterator);
+    void evict();
+
+    // Ordered from least to most recently added.
+    Entries entries;
+    std::unordered_map<Key, Entries::iterator, KeyHash> index;
 
-    size_t size;
+    uint64_t size;
+    uint64_t used = 0;
 };
 
 } // namespace mbgl
@@ -0,0 +1,31 @@
+#include <mbgl/tile/tile_cancellation.hpp>
+
+namespace mbgl {
+
+namespace {
+
+std::atomic<uint64_t> skippedFeatureCount { 0 };
+std::atomic<uint64_t> skippedSymbolCount { 0 };
+
+} // namespace
+
+TileCancellation::Stats TileCancellation::getStats() {
+    Stats stats;
+    stats.features = skippedFeatureCount;
+    stats.symbols = skippedSymbolCount;
+    return stats;
+}
+
+void TileCancellation::skippedFeatures(std::size_t count) const {
+    if (count) {
+        skippedFeatureCount += count;
+    }
+}
+
+void TileCancellation::skippedSymbols(std::size_t count) const {
+    if (count) {
+        skippedSymbolCount += count;
+    }
+}
+
+} // namespace mbgl
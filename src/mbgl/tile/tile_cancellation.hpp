@@ -0,0 +1,41 @@
+#ifndef MBGL_TILE_TILE_CANCELLATION
+#define MBGL_TILE_TILE_CANCELLATION
+
+#include <mbgl/tile/tile_data.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+
+// Parsing and placement of a dense tile can take a while on a worker thread. The loops over
+// features and symbols check this so that they stop soon after their tile became obsolete,
+// and record how much work they skipped as a result.
+class TileCancellation {
+public:
+    explicit TileCancellation(const std::atomic<TileData::State>& state_)
+        : state(state_) {}
+
+    bool cancelled() const {
+        return state == TileData::State::obsolete;
+    }
+
+    // Work skipped because of cancellation, counted across all tiles in this process.
+    struct Stats {
+        uint64_t features = 0;
+        uint64_t symbols = 0;
+    };
+
+    static Stats getStats();
+
+    void skippedFeatures(std::size_t) const;
+    void skippedSymbols(std::size_t) const;
+
+private:
+    const std::atomic<TileData::State>& state;
+};
+
+} // namespace mbgl
+
+#endif
@@ -7,8 +7,10 @@
 #include <mbgl/map/tile_id.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/text/placement_config.hpp>
+#include <mbgl/text/collision_feature.hpp>
 
 #include <atomic>
+#include <cstddef>
 #include <string>
 #include <memory>
 #include <functional>
@@ -79,9 +81,22 @@ public:
     virtual Bucket* getBucket(const StyleLayer&) = 0;
 
     virtual bool parsePending(std::function<void (std::exception_ptr)>) { return true; }
-    virtual void redoPlacement(PlacementConfig, const std::function<void()>&) {}
+    virtual void redoPlacement(PlacementConfig, const NeighbourBoxes&, const std::function<void()>&) {}
     virtual void redoPlacement(const std::function<void()>&) {}
 
+    // The boxes of the labels this tile placed close to its edges, or null while the tile
+    // hasn't been placed for the current configuration yet.
+    virtual std::shared_ptr<const BorderBoxes> getBorderBoxes() const { return nullptr; }
+
+    // Tiles with lower values are loaded and parsed first. Source ranks its tiles by distance
+    // from the center of the viewport, and re-ranks them whenever the camera moves.
+    virtual void setPriority(int32_t priority_) { priority = priority_; }
+    int32_t getPriority() const { return priority; }
+
+    // Returns the memory held by the buckets of this tile, in CPU memory and on the GPU. The
+    // TileCache uses this to stay within its budget.
+    virtual std::size_t getByteSize() const { return 0; }
+
     bool isReady() const {
         return isReadyState(state);
     }
@@ -101,6 +116,7 @@ public:
 
 protected:
     std::atomic<State> state;
+    int32_t priority = 0;
 };
 
 } // namespace mbgl
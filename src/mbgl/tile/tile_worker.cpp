@@ -1,6 +1,7 @@
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/tile/tile_worker.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/tile/cached_geometry_tile.hpp>
 #include <mbgl/style/style_layer.hpp>
 #include <mbgl/style/style_bucket_parameters.hpp>
 #include <mbgl/layer/background_layer.hpp>
@@ -22,14 +23,16 @@ TileWorker::TileWorker(TileID id_,
                        GlyphAtlas& glyphAtlas_,
                        GlyphStore& glyphStore_,
                        const std::atomic<TileData::State>& state_,
-                       const MapMode mode_)
+                       const MapMode mode_,
+                       float simplificationTolerance_)
     : id(id_),
       sourceID(std::move(sourceID_)),
       spriteStore(spriteStore_),
       glyphAtlas(glyphAtlas_),
       glyphStore(glyphStore_),
-      state(state_),
-      mode(mode_) {
+      cancellation(state_),
+      mode(mode_),
+      simplificationTolerance(simplificationTolerance_) {
 }
 
 TileWorker::~TileWorker() {
@@ -51,11 +54,14 @@ TileParseResult TileWorker::parseAllLayers(std::vector<std::unique_ptr<StyleLaye
     // referenced from more than one layer
     std::set<std::string> parsed;
 
+    // Style layers frequently share source layers; decode each source layer's features only once.
+    const CachedGeometryTile cachedTile(*geometryTile);
+
     for (auto i = layers.rbegin(); i != layers.rend(); i++) {
         const StyleLayer* layer = i->get();
         if (parsed.find(layer->bucketName()) == parsed.end()) {
             parsed.emplace(layer->bucketName());
-            parseLayer(layer, *geometryTile);
+            parseLayer(layer, cachedTile);
         }
     }
 
@@ -80,7 +86,8 @@ TileParseResult TileWorker::parsePendingLayers(const PlacementConfig config) {
             bucket->addFeatures(reinterpret_cast<uintptr_t>(this),
                                 *layer.spriteAtlas,
                                 glyphAtlas,
-                                glyphStore);
+                                glyphStore,
+                                cancellation);
             placementPending.emplace(layer.bucketName(), std::move(it->second));
             pending.erase(it++);
             continue;
@@ -100,7 +107,9 @@ TileParseResult TileWorker::parsePendingLayers(const PlacementConfig config) {
 }
 
 void TileWorker::placeLayers(const PlacementConfig config) {
-    redoPlacement(&placementPending, config);
+    // Labels are placed without their neighbours here. The tile is placed again around them
+    // once it has been loaded.
+    result.borderBoxes = redoPlacement(&placementPending, config, {});
     for (auto &p : placementPending) {
         p.second->swapRenderData();
         insertBucket(p.first, std::move(p.second));
@@ -108,23 +117,27 @@ void TileWorker::placeLayers(const PlacementConfig config) {
     placementPending.clear();
 }
 
-void TileWorker::redoPlacement(
+std::shared_ptr<const BorderBoxes> TileWorker::redoPlacement(
     const std::unordered_map<std::string, std::unique_ptr<Bucket>>* buckets,
-    PlacementConfig config) {
+    PlacementConfig config,
+    const NeighbourBoxes& neighbours) {
 
     CollisionTile collisionTile(config);
+    collisionTile.insertNeighbourBoxes(neighbours);
 
     for (auto i = layers.rbegin(); i != layers.rend(); i++) {
         const auto it = buckets->find((*i)->id);
         if (it != buckets->end()) {
-            it->second->placeFeatures(collisionTile);
+            it->second->placeFeatures(collisionTile, cancellation);
         }
     }
+
+    return std::make_shared<const BorderBoxes>(collisionTile.getBorderBoxes());
 }
 
 void TileWorker::parseLayer(const StyleLayer* layer, const GeometryTile& geometryTile) {
     // Cancel early when parsing.
-    if (state == TileData::State::obsolete)
+    if (cancellation.cancelled())
         return;
 
     // Background and custom layers are special cases.
@@ -151,13 +164,14 @@ void TileWorker::parseLayer(const StyleLayer* layer, const GeometryTile& geometr
 
     StyleBucketParameters parameters(id,
                                      *geometryLayer,
-                                     state,
+                                     cancellation,
                                      reinterpret_cast<uintptr_t>(this),
                                      partialParse,
                                      spriteStore,
                                      glyphAtlas,
                                      glyphStore,
-                                     mode);
+                                     mode,
+                                     simplificationTolerance);
 
     std::unique_ptr<Bucket> bucket = layer->createBucket(parameters);
 
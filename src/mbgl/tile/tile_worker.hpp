@@ -5,9 +5,11 @@
 
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_data.hpp>
+#include <mbgl/tile/tile_cancellation.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/ptr.hpp>
 #include <mbgl/text/placement_config.hpp>
+#include <mbgl/text/collision_feature.hpp>
 
 #include <string>
 #include <memory>
@@ -32,6 +34,9 @@ class TileParseResultBuckets {
 public:
     TileData::State state = TileData::State::invalid;
     std::unordered_map<std::string, std::unique_ptr<Bucket>> buckets;
+
+    // Set when the symbols of the tile have been placed.
+    std::shared_ptr<const BorderBoxes> borderBoxes;
 };
 
 using TileParseResult = mapbox::util::variant<
@@ -46,7 +51,8 @@ public:
                GlyphAtlas&,
                GlyphStore&,
                const std::atomic<TileData::State>&,
-               const MapMode);
+               const MapMode,
+               float simplificationTolerance);
     ~TileWorker();
 
     TileParseResult parseAllLayers(std::vector<std::unique_ptr<StyleLayer>>,
@@ -55,8 +61,10 @@ public:
 
     TileParseResult parsePendingLayers(PlacementConfig);
 
-    void redoPlacement(const std::unordered_map<std::string, std::unique_ptr<Bucket>>*,
-                       PlacementConfig);
+    std::shared_ptr<const BorderBoxes>
+    redoPlacement(const std::unordered_map<std::string, std::unique_ptr<Bucket>>*,
+                  PlacementConfig,
+                  const NeighbourBoxes&);
 
 private:
     void parseLayer(const StyleLayer*, const GeometryTile&);
@@ -69,9 +77,12 @@ private:
     SpriteStore& spriteStore;
     GlyphAtlas& glyphAtlas;
     GlyphStore& glyphStore;
-    const std::atomic<TileData::State>& state;
+    const TileCancellation cancellation;
     const MapMode mode;
 
+    // Lines and polygons are simplified by this many pixels.
+    const float simplificationTolerance;
+
     bool partialParse = false;
 
     std::vector<std::unique_ptr<StyleLayer>> layers;
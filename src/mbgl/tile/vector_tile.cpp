@@ -4,7 +4,9 @@
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/util/url.hpp>
+#include <mbgl/map/shared_tile_cache.hpp>
 
+#include <stdexcept>
 #include <utility>
 
 namespace mbgl {
@@ -36,21 +38,16 @@ Value parseValue(pbf data) {
     return false;
 }
 
-VectorTileFeature::VectorTileFeature(pbf feature_pbf, const VectorTileLayer& layer_)
-    : layer(layer_) {
-    while (feature_pbf.next()) {
-        if (feature_pbf.tag == 1) { // id
-            id = feature_pbf.varint<uint64_t>();
-        } else if (feature_pbf.tag == 2) { // tags
-            tags_pbf = feature_pbf.message();
-        } else if (feature_pbf.tag == 3) { // type
-            type = (FeatureType)feature_pbf.varint();
-        } else if (feature_pbf.tag == 4) { // geometry
-            geometry_pbf = feature_pbf.message();
-        } else {
-            feature_pbf.skip();
-        }
-    }
+VectorTileFeature::VectorTileFeature(const VectorTileLayer& layer_, std::size_t index_)
+    : layer(layer_), index(index_) {
+}
+
+uint64_t VectorTileFeature::getID() const {
+    return layer.featureIDs[index];
+}
+
+FeatureType VectorTileFeature::getType() const {
+    return layer.featureTypes[index];
 }
 
 optional<Value> VectorTileFeature::getValue(const std::string& key) const {
@@ -59,42 +56,41 @@ optional<Value> VectorTileFeature::getValue(const std::string& key) const {
         return optional<Value>();
     }
 
-    pbf tags = tags_pbf;
-    while (tags) {
-        uint32_t tag_key = tags.varint();
+    return getIndexedValue(keyIter->second);
+}
 
-        if (layer.keys.size() <= tag_key) {
-            throw std::runtime_error("feature referenced out of range key");
+optional<Value> VectorTileFeature::getIndexedValue(uint32_t key) const {
+    const auto end = layer.tags.begin() + layer.tagOffsets[index + 1];
+    for (auto it = layer.tags.begin() + layer.tagOffsets[index]; it != end; ++it) {
+        if (it->first == key) {
+            return layer.getValue(it->second);
         }
+    }
 
-        if (!tags) {
-            throw std::runtime_error("uneven number of feature tag ids");
-        }
+    return optional<Value>();
+}
 
-        uint32_t tag_val = tags.varint();
-        if (layer.values.size() <= tag_val) {
-            throw std::runtime_error("feature referenced out of range value");
-        }
+GeometryCollection VectorTileFeature::getGeometries() const {
+    GeometryCollection lines;
+    GeometryCollectionBuilder builder(lines);
+    visitGeometries(builder);
 
-        if (tag_key == keyIter->second) {
-            return layer.values[tag_val];
-        }
+    if (lines.empty()) {
+        lines.emplace_back();
     }
 
-    return optional<Value>();
+    return lines;
 }
 
-GeometryCollection VectorTileFeature::getGeometries() const {
-    pbf data(geometry_pbf);
+void VectorTileFeature::visitGeometries(GeometryVisitor& visitor) const {
+    pbf data(layer.featureGeometries[index]);
     uint8_t cmd = 1;
     uint32_t length = 0;
     int32_t x = 0;
     int32_t y = 0;
 
-    GeometryCollection lines;
-
-    lines.emplace_back();
-    std::vector<Coordinate>* line = &lines.back();
+    bool inLine = false;
+    Coordinate first(0, 0);
 
     while (data.data < data.end) {
         if (length == 0) {
@@ -109,16 +105,23 @@ GeometryCollection VectorTileFeature::getGeometries() const {
             x += data.svarint();
             y += data.svarint();
 
-            if (cmd == 1 && !line->empty()) { // moveTo
-                lines.emplace_back();
-                line = &lines.back();
+            if (cmd == 1 && inLine) { // moveTo
+                visitor.endLine();
+                inLine = false;
             }
 
-            line->emplace_back(x, y);
+            const Coordinate point(x, y);
+            if (!inLine) {
+                visitor.beginLine();
+                inLine = true;
+                first = point;
+            }
+
+            visitor.addPoint(point);
 
         } else if (cmd == 7) { // closePolygon
-            if (!line->empty()) {
-                line->push_back((*line)[0]);
+            if (inLine) {
+                visitor.addPoint(first);
             }
 
         } else {
@@ -126,7 +129,9 @@ GeometryCollection VectorTileFeature::getGeometries() const {
         }
     }
 
-    return lines;
+    if (inLine) {
+        visitor.endLine();
+    }
 }
 
 uint32_t VectorTileFeature::getExtent() const {
@@ -138,13 +143,18 @@ VectorTile::VectorTile(std::shared_ptr<const std::string> data_)
 }
 
 util::ptr<GeometryTileLayer> VectorTile::getLayer(const std::string& name) const {
-    if (!parsed) {
-        parsed = true;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!indexed) {
+        indexed = true;
         pbf tile_pbf(reinterpret_cast<const unsigned char *>(data->c_str()), data->size());
         while (tile_pbf.next()) {
             if (tile_pbf.tag == 3) { // layer
-                util::ptr<VectorTileLayer> layer = std::make_shared<VectorTileLayer>(tile_pbf.message());
-                layers.emplace(layer->name, layer);
+                pbf layer_pbf = tile_pbf.message();
+                pbf name_pbf = layer_pbf;
+                if (name_pbf.next(1)) { // name
+                    layerIndex.emplace(name_pbf.string(), layer_pbf);
+                }
             } else {
                 tile_pbf.skip();
             }
@@ -156,10 +166,20 @@ util::ptr<GeometryTileLayer> VectorTile::getLayer(const std::string& name) const
         return layer_it->second;
     }
 
+    auto index_it = layerIndex.find(name);
+    if (index_it != layerIndex.end()) {
+        util::ptr<GeometryTileLayer> layer = std::make_shared<VectorTileLayer>(index_it->second);
+        layers.emplace(name, layer);
+        return layer;
+    }
+
     return nullptr;
 }
 
 VectorTileLayer::VectorTileLayer(pbf layer_pbf) {
+    // Features may precede the keys and values they reference, so they're decoded afterwards.
+    std::vector<pbf> features;
+
     while (layer_pbf.next()) {
         if (layer_pbf.tag == 1) { // name
             name = layer_pbf.string();
@@ -168,35 +188,154 @@ VectorTileLayer::VectorTileLayer(pbf layer_pbf) {
         } else if (layer_pbf.tag == 3) { // keys
             keys.emplace(layer_pbf.string(), keys.size());
         } else if (layer_pbf.tag == 4) { // values
-            values.emplace_back(parseValue(layer_pbf.message()));
+            values.push_back(layer_pbf.message());
         } else if (layer_pbf.tag == 5) { // extent
             extent = layer_pbf.varint();
         } else {
             layer_pbf.skip();
         }
     }
+
+    decodedValues.reset(new std::atomic<const Value*>[values.size()]());
+
+    featureTypes.reserve(features.size());
+    featureIDs.reserve(features.size());
+    tagOffsets.reserve(features.size() + 1);
+    featureGeometries.reserve(features.size());
+
+    std::vector<uint32_t> tagIDs;
+    for (const auto& feature : features) {
+        addFeature(feature, tagIDs);
+    }
+}
+
+VectorTileLayer::~VectorTileLayer() {
+    for (std::size_t i = 0; i < values.size(); i++) {
+        delete decodedValues[i].load();
+    }
+}
+
+void VectorTileLayer::addFeature(pbf feature_pbf, std::vector<uint32_t>& tagIDs) {
+    uint64_t id = 0;
+    FeatureType type = FeatureType::Unknown;
+    pbf tags_pbf;
+    pbf geometry_pbf;
+
+    while (feature_pbf.next()) {
+        if (feature_pbf.tag == 1) { // id
+            id = feature_pbf.varint<uint64_t>();
+        } else if (feature_pbf.tag == 2) { // tags
+            tags_pbf = feature_pbf.message();
+        } else if (feature_pbf.tag == 3) { // type
+            type = (FeatureType)feature_pbf.varint();
+        } else if (feature_pbf.tag == 4) { // geometry
+            geometry_pbf = feature_pbf.message();
+        } else {
+            feature_pbf.skip();
+        }
+    }
+
+    tagIDs.clear();
+    tags_pbf.varints(tagIDs);
+
+    if (tagIDs.size() % 2) {
+        throw std::runtime_error("uneven number of feature tag ids");
+    }
+
+    for (std::size_t i = 0; i < tagIDs.size(); i += 2) {
+        if (keys.size() <= tagIDs[i]) {
+            throw std::runtime_error("feature referenced out of range key");
+        }
+
+        if (values.size() <= tagIDs[i + 1]) {
+            throw std::runtime_error("feature referenced out of range value");
+        }
+
+        tags.emplace_back(tagIDs[i], tagIDs[i + 1]);
+    }
+
+    featureIDs.push_back(id);
+    featureTypes.push_back(type);
+    tagOffsets.push_back(tags.size());
+    featureGeometries.push_back(geometry_pbf);
+}
+
+const Value& VectorTileLayer::getValue(uint32_t i) const {
+    const Value* value = decodedValues[i].load(std::memory_order_acquire);
+    if (!value) {
+        auto decoded = std::make_unique<const Value>(parseValue(values[i]));
+        if (decodedValues[i].compare_exchange_strong(value, decoded.get(), std::memory_order_acq_rel)) {
+            value = decoded.release();
+        }
+    }
+    return *value;
 }
 
 util::ptr<const GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i) const {
-    return std::make_shared<VectorTileFeature>(features.at(i), *this);
+    if (i >= featureCount()) {
+        throw std::out_of_range("feature index out of range");
+    }
+    return std::make_shared<VectorTileFeature>(*this, i);
 }
 
-VectorTileMonitor::VectorTileMonitor(const TileID& tileID_, float pixelRatio_, const std::string& urlTemplate_, FileSource& fileSource_)
+std::size_t VectorTileLayer::eachFeature(const std::function<void (const GeometryTileFeature&)>& function,
+                                         const std::function<bool ()>& stop) const {
+    const std::size_t count = featureCount();
+    for (std::size_t i = 0; i < count; i++) {
+        if (stop && stop()) {
+            return i;
+        }
+        function(VectorTileFeature(*this, i));
+    }
+    return count;
+}
+
+optional<uint32_t> VectorTileLayer::getKeyIndex(const std::string& key) const {
+    auto it = keys.find(key);
+    // Keys that don't occur in this layer resolve to an index that no feature references.
+    return it != keys.end() ? it->second : uint32_t(keys.size());
+}
+
+namespace {
+
+// Hands a tile from the SharedTileCache to a single parse.
+class SharedGeometryTile : public GeometryTile {
+public:
+    SharedGeometryTile(std::shared_ptr<const GeometryTile> tile_)
+        : tile(std::move(tile_)) {}
+
+    util::ptr<GeometryTileLayer> getLayer(const std::string& name) const override {
+        return tile->getLayer(name);
+    }
+
+private:
+    const std::shared_ptr<const GeometryTile> tile;
+};
+
+} // namespace
+
+VectorTileMonitor::VectorTileMonitor(const TileID& tileID_, float pixelRatio_, const std::string& urlTemplate_, FileSource& fileSource_,
+                                     SharedTileCache* sharedCache_)
     : tileID(tileID_),
       pixelRatio(pixelRatio_),
       urlTemplate(urlTemplate_),
-      fileSource(fileSource_) {
+      fileSource(fileSource_),
+      sharedCache(sharedCache_) {
 }
 
 std::unique_ptr<FileRequest> VectorTileMonitor::monitorTile(const GeometryTileMonitor::Callback& callback) {
     const Resource resource = Resource::tile(urlTemplate, pixelRatio, tileID.x, tileID.y, tileID.sourceZ);
-    return fileSource.request(resource, [callback, this](Response res) {
+    return fileSource.request(resource, [callback, this, url = resource.url](Response res) {
         if (res.error) {
             callback(std::make_exception_ptr(std::runtime_error(res.error->message)), nullptr, res.modified, res.expires);
         } else if (res.notModified) {
             return;
         } else if (res.noContent) {
+            sharedTile.reset();
             callback(nullptr, nullptr, res.modified, res.expires);
+        } else if (sharedCache) {
+            sharedTile = sharedCache->get(url, res.data);
+            callback(nullptr, std::make_unique<SharedGeometryTile>(sharedTile), res.modified, res.expires);
         } else {
             callback(nullptr, std::make_unique<VectorTile>(res.data), res.modified, res.expires);
         }
@@ -5,45 +5,70 @@
 #include <mbgl/map/tile_id.hpp>
 #include <mbgl/util/pbf.hpp>
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 
 namespace mbgl {
 
 class VectorTileLayer;
 
+// A lightweight view onto a single row of a VectorTileLayer's feature table. It doesn't own any
+// data and is cheap enough to be constructed on the stack for every feature that gets visited.
 class VectorTileFeature : public GeometryTileFeature {
 public:
-    VectorTileFeature(pbf, const VectorTileLayer&);
+    VectorTileFeature(const VectorTileLayer&, std::size_t index);
 
-    FeatureType getType() const override { return type; }
+    uint64_t getID() const;
+    FeatureType getType() const override;
     optional<Value> getValue(const std::string&) const override;
+    optional<Value> getIndexedValue(uint32_t) const override;
     GeometryCollection getGeometries() const override;
+    void visitGeometries(GeometryVisitor&) const override;
     uint32_t getExtent() const override;
 
 private:
     const VectorTileLayer& layer;
-    uint64_t id = 0;
-    FeatureType type = FeatureType::Unknown;
-    pbf tags_pbf;
-    pbf geometry_pbf;
+    const std::size_t index;
 };
 
 class VectorTileLayer : public GeometryTileLayer {
 public:
     VectorTileLayer(pbf);
+    ~VectorTileLayer() override;
 
-    std::size_t featureCount() const override { return features.size(); }
+    std::size_t featureCount() const override { return featureTypes.size(); }
     util::ptr<const GeometryTileFeature> getFeature(std::size_t) const override;
+    std::size_t eachFeature(const std::function<void (const GeometryTileFeature&)>&,
+                            const std::function<bool ()>& stop = {}) const override;
+    optional<uint32_t> getKeyIndex(const std::string&) const override;
 
 private:
     friend class VectorTile;
     friend class VectorTileFeature;
 
+    void addFeature(pbf, std::vector<uint32_t>& tagIDs);
+    const Value& getValue(uint32_t) const;
+
     std::string name;
     uint32_t extent = 4096;
     std::map<std::string, uint32_t> keys;
-    std::vector<Value> values;
-    std::vector<pbf> features;
+    // Values are only decoded when a feature is asked for them; most of them never are. Each
+    // value is decoded once. Layers can be shared by several maps through a SharedTileCache, so
+    // decoded values are published atomically; a value decoded by two threads at once is kept
+    // from whichever thread publishes first.
+    std::vector<pbf> values;
+    std::unique_ptr<std::atomic<const Value*>[]> decodedValues;
+
+    // Columnar feature table, decoded once when the layer is parsed. The tags of feature i are the
+    // (key, value) index pairs tags[tagOffsets[i]] up to tags[tagOffsets[i + 1]]. The geometry
+    // column holds byte ranges into the tile data that are decoded on demand.
+    std::vector<FeatureType> featureTypes;
+    std::vector<uint64_t> featureIDs;
+    std::vector<std::size_t> tagOffsets { 0 };
+    std::vector<std::pair<uint32_t, uint32_t>> tags;
+    std::vector<pbf> featureGeometries;
 };
 
 class VectorTile : public GeometryTile {
@@ -54,16 +79,25 @@ public:
 
 private:
     std::shared_ptr<const std::string> data;
-    mutable bool parsed = false;
+
+    // The first access only indexes the names and byte ranges of all layers. A layer's keys,
+    // values and features are decoded when it is requested for the first time. Tiles can be
+    // shared by several maps through a SharedTileCache, so the lazy decoding is synchronized.
+    mutable std::mutex mutex;
+    mutable bool indexed = false;
+    mutable std::map<std::string, pbf> layerIndex;
     mutable std::map<std::string, util::ptr<GeometryTileLayer>> layers;
 };
 
 class TileID;
 class FileSource;
+class SharedTileCache;
 
 class VectorTileMonitor : public GeometryTileMonitor {
 public:
-    VectorTileMonitor(const TileID&, float pixelRatio, const std::string& urlTemplate, FileSource&);
+    // When a SharedTileCache is given, maps that load the same tile share its decoded data.
+    VectorTileMonitor(const TileID&, float pixelRatio, const std::string& urlTemplate, FileSource&,
+                      SharedTileCache* = nullptr);
 
     std::unique_ptr<FileRequest> monitorTile(const GeometryTileMonitor::Callback&) override;
 
@@ -72,6 +106,11 @@ private:
     float pixelRatio;
     std::string urlTemplate;
     FileSource& fileSource;
+    SharedTileCache* sharedCache;
+
+    // Holds on to the shared tile for as long as this tile is in use, so that other maps can
+    // pick it up from the cache.
+    std::shared_ptr<const GeometryTile> sharedTile;
 };
 
 } // namespace mbgl
@@ -13,6 +13,7 @@ VectorTileData::VectorTileData(const TileID& id_,
                                std::string sourceID,
                                Style& style_,
                                const MapMode mode_,
+                               float simplificationTolerance,
                                const std::function<void(std::exception_ptr)>& callback)
     : TileData(id_),
       style(style_),
@@ -23,7 +24,8 @@ VectorTileData::VectorTileData(const TileID& id_,
                  *style_.glyphAtlas,
                  *style_.glyphStore,
                  state,
-                 mode_),
+                 mode_,
+                 simplificationTolerance),
       monitor(std::move(monitor_))
 {
     state = State::loading;
@@ -44,6 +46,7 @@ VectorTileData::VectorTileData(const TileID& id_,
             workRequest.reset();
             state = State::parsed;
             buckets.clear();
+            borderBoxes = std::make_shared<const BorderBoxes>();
             callback(err);
             return;
         }
@@ -58,7 +61,7 @@ VectorTileData::VectorTileData(const TileID& id_,
         // when tile data changed. Replacing the workdRequest will cancel a pending work
         // request in case there is one.
         workRequest.reset();
-        workRequest = worker.parseGeometryTile(tileWorker, style.getLayers(), std::move(tile), targetConfig, [callback, this, config = targetConfig] (TileParseResult result) {
+        workRequest = worker.parseGeometryTile(tileWorker, style.getLayers(), std::move(tile), targetConfig, priority, [callback, this, config = targetConfig] (TileParseResult result) {
             workRequest.reset();
             if (state == State::obsolete) {
                 return;
@@ -72,6 +75,8 @@ VectorTileData::VectorTileData(const TileID& id_,
                 // Persist the configuration we just placed so that we can later check whether we need to
                 // place again in case the configuration has changed.
                 placedConfig = config;
+                placedNeighbours = {};
+                borderBoxes = std::move(resultBuckets.borderBoxes);
 
                 // Move over all buckets we received in this parse request, potentially overwriting
                 // existing buckets in case we got a refresh parse.
@@ -98,7 +103,7 @@ bool VectorTileData::parsePending(std::function<void(std::exception_ptr)> callba
     }
 
     workRequest.reset();
-    workRequest = worker.parsePendingGeometryTileLayers(tileWorker, targetConfig, [this, callback, config = targetConfig] (TileParseResult result) {
+    workRequest = worker.parsePendingGeometryTileLayers(tileWorker, targetConfig, priority, [this, callback, config = targetConfig] (TileParseResult result) {
         workRequest.reset();
         if (state == State::obsolete) {
             return;
@@ -118,6 +123,8 @@ bool VectorTileData::parsePending(std::function<void(std::exception_ptr)> callba
             // Persist the configuration we just placed so that we can later check whether we need to
             // place again in case the configuration has changed.
             placedConfig = config;
+            placedNeighbours = {};
+            borderBoxes = std::move(resultBuckets.borderBoxes);
 
         } else {
             error = result.get<std::exception_ptr>();
@@ -140,10 +147,13 @@ Bucket* VectorTileData::getBucket(const StyleLayer& layer) {
     return it->second.get();
 }
 
-void VectorTileData::redoPlacement(const PlacementConfig newConfig, const std::function<void()>& callback) {
-    if (newConfig != placedConfig) {
-        targetConfig = newConfig;
+void VectorTileData::redoPlacement(const PlacementConfig newConfig,
+                                   const NeighbourBoxes& neighbours,
+                                   const std::function<void()>& callback) {
+    targetConfig = newConfig;
+    targetNeighbours = neighbours;
 
+    if (!targetConfig.isEquivalent(placedConfig) || targetNeighbours != placedNeighbours) {
         redoPlacement(callback);
     }
 }
@@ -153,12 +163,16 @@ void VectorTileData::redoPlacement(const std::function<void()>& callback) {
     // we are parsing buckets.
     if (workRequest) return;
 
-    workRequest = worker.redoPlacement(tileWorker, buckets, targetConfig, [this, callback, config = targetConfig] {
+    workRequest = worker.redoPlacement(tileWorker, buckets, targetConfig, targetNeighbours, priority,
+                                       [this, callback, config = targetConfig, neighbours = targetNeighbours]
+                                       (std::shared_ptr<const BorderBoxes> result) {
         workRequest.reset();
 
         // Persist the configuration we just placed so that we can later check whether we need to
         // place again in case the configuration has changed.
         placedConfig = config;
+        placedNeighbours = neighbours;
+        borderBoxes = std::move(result);
 
         for (auto& bucket : buckets) {
             bucket.second->swapRenderData();
@@ -166,7 +180,7 @@ void VectorTileData::redoPlacement(const std::function<void()>& callback) {
 
         // The target configuration could have changed since we started placement. In this case,
         // we're starting another placement run.
-        if (placedConfig != targetConfig) {
+        if (!targetConfig.isEquivalent(placedConfig) || placedNeighbours != targetNeighbours) {
             redoPlacement(callback);
         } else {
             callback();
@@ -174,6 +188,36 @@ void VectorTileData::redoPlacement(const std::function<void()>& callback) {
     });
 }
 
+std::shared_ptr<const BorderBoxes> VectorTileData::getBorderBoxes() const {
+    if (workRequest || !targetConfig.isEquivalent(placedConfig)) {
+        return nullptr;
+    }
+    return borderBoxes;
+}
+
+void VectorTileData::setPriority(int32_t priority_) {
+    if (priority == priority_) {
+        return;
+    }
+
+    priority = priority_;
+
+    if (tileRequest) {
+        tileRequest->setPriority(priority);
+    }
+    if (workRequest) {
+        workRequest->setPriority(priority);
+    }
+}
+
+std::size_t VectorTileData::getByteSize() const {
+    std::size_t size = 0;
+    for (const auto& bucket : buckets) {
+        size += bucket.second->getByteSize();
+    }
+    return size;
+}
+
 void VectorTileData::cancel() {
     state = State::obsolete;
     tileRequest.reset();
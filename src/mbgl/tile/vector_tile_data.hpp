@@ -23,6 +23,7 @@ public:
                    std::string sourceID,
                    Style&,
                    const MapMode,
+                   float simplificationTolerance,
                    const std::function<void(std::exception_ptr)>& callback);
 
     ~VectorTileData();
@@ -31,9 +32,14 @@ public:
 
     bool parsePending(std::function<void(std::exception_ptr)> callback) override;
 
-    void redoPlacement(PlacementConfig config, const std::function<void()>&) override;
+    void redoPlacement(PlacementConfig config, const NeighbourBoxes&, const std::function<void()>&) override;
     void redoPlacement(const std::function<void()>&) override;
 
+    std::shared_ptr<const BorderBoxes> getBorderBoxes() const override;
+
+    void setPriority(int32_t) override;
+    std::size_t getByteSize() const override;
+
     void cancel() override;
 
 private:
@@ -55,6 +61,14 @@ private:
     // Stores the placement configuration of how the text should be placed. This isn't necessarily
     // the one that is being displayed.
     PlacementConfig targetConfig;
+
+    // The labels of the neighbouring tiles that the text currently on the screen was placed
+    // around, and the ones it should be placed around.
+    NeighbourBoxes placedNeighbours;
+    NeighbourBoxes targetNeighbours;
+
+    // The labels of the current placement that neighbouring tiles need to be placed around.
+    std::shared_ptr<const BorderBoxes> borderBoxes;
 };
 
 } // namespace mbgl
@@ -30,6 +30,7 @@ const double MIN_ZOOM = 0.0;
 const double MAX_ZOOM = 25.5;
 
 const uint64_t DEFAULT_MAX_CACHE_SIZE = 50 * 1024 * 1024;
+const uint64_t DEFAULT_TILE_CACHE_SIZE = 32 * 1024 * 1024;
 
 } // namespace util
 
@@ -0,0 +1,690 @@
+#include <mbgl/util/earcut.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+// Polygons with more vertices than this are indexed in z-order, so that finding the vertices
+// inside a candidate ear doesn't need to visit the whole ring.
+const std::size_t hashThreshold = 80;
+
+// Relative difference between the area of the polygon and the area of its triangles above which
+// the triangulation is considered wrong. Triangulations of valid polygons are exact, since tile
+// coordinates are small integers.
+const double maxDeviation = 1e-6;
+
+template <typename Node>
+double area(const Node* p, const Node* q, const Node* r) {
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+template <typename Node>
+bool equals(const Node* p1, const Node* p2) {
+    return p1->x == p2->x && p1->y == p2->y;
+}
+
+bool pointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py) {
+    return (cx - px) * (ay - py) - (ax - px) * (cy - py) >= 0 &&
+           (ax - px) * (by - py) - (bx - px) * (ay - py) >= 0 &&
+           (bx - px) * (cy - py) - (cx - px) * (by - py) >= 0;
+}
+
+template <typename Node>
+bool intersects(const Node* p1, const Node* q1, const Node* p2, const Node* q2) {
+    if ((equals(p1, q1) && equals(p2, q2)) || (equals(p1, q2) && equals(p2, q1))) {
+        return true;
+    }
+    return (area(p1, q1, p2) > 0) != (area(p1, q1, q2) > 0) &&
+           (area(p2, q2, p1) > 0) != (area(p2, q2, q1) > 0);
+}
+
+// Whether the diagonal from a to b starts out on the inside of the polygon at a.
+template <typename Node>
+bool locallyInside(const Node* a, const Node* b) {
+    return area(a->prev, a, a->next) < 0 ?
+        area(a, b, a->next) >= 0 && area(a, a->prev, b) >= 0 :
+        area(a, b, a->prev) < 0 || area(a, a->next, b) < 0;
+}
+
+// Whether the point is inside the ring, by the even-odd rule.
+bool contains(const std::vector<Coordinate>& ring, const Coordinate& p) {
+    bool inside = false;
+    for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        const Coordinate& a = ring[i];
+        const Coordinate& b = ring[j];
+        if ((a.y > p.y) != (b.y > p.y) &&
+            p.x < double(b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+} // namespace
+
+double signedArea(const std::vector<Coordinate>& ring) {
+    double sum = 0;
+    for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        sum += double(ring[j].x - ring[i].x) * double(ring[i].y + ring[j].y);
+    }
+    return sum;
+}
+
+bool windingMatchesNesting(GeometryCollection::const_iterator first, GeometryCollection::const_iterator last) {
+    if (first == last) {
+        return true;
+    }
+
+    const bool outerWinding = signedArea(*first) > 0;
+
+    // The current outer ring, its bounding box and the holes found in it so far.
+    GeometryCollection::const_iterator outer;
+    std::vector<GeometryCollection::const_iterator> holes;
+    Coordinate min, max;
+    auto setOuter = [&] (GeometryCollection::const_iterator ring) {
+        outer = ring;
+        holes.clear();
+        min = max = ring->front();
+        for (const auto& point : *ring) {
+            min = { std::min(min.x, point.x), std::min(min.y, point.y) };
+            max = { std::max(max.x, point.x), std::max(max.y, point.y) };
+        }
+    };
+    setOuter(first);
+
+    for (auto ring = std::next(first); ring != last; ++ring) {
+        // Tests the first point of the ring against the outer ring and its holes by the even-odd
+        // rule, so that an island inside a hole counts as outside. Rings of a valid polygon don't
+        // cross, so one point tells on which side the whole ring is.
+        const Coordinate& p = ring->front();
+        bool inside = false;
+        if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y) {
+            inside = contains(*outer, p);
+            for (const auto& hole : holes) {
+                inside = inside != contains(*hole, p);
+            }
+        }
+
+        const bool isOuter = (signedArea(*ring) > 0) == outerWinding;
+        if (isOuter == inside) {
+            return false;
+        }
+
+        if (isOuter) {
+            setOuter(ring);
+        } else {
+            holes.push_back(ring);
+        }
+    }
+
+    return true;
+}
+
+bool Earcut::operator()(GeometryCollection::const_iterator first,
+                        GeometryCollection::const_iterator last,
+                        std::vector<uint32_t>& indices) {
+    if (first == last || first->size() < 3) {
+        return true;
+    }
+
+    nodes.clear();
+    triangles = &indices;
+    const std::size_t start = indices.size();
+
+    const std::vector<Coordinate>& outerRing = *first;
+    Node* outerNode = linkedList(outerRing, 0, true);
+    if (!outerNode || outerNode->next == outerNode->prev) {
+        return true;
+    }
+
+    uint32_t offset = static_cast<uint32_t>(outerRing.size());
+    std::vector<Node*> holes;
+    for (auto it = std::next(first); it != last; ++it) {
+        Node* list = linkedList(*it, offset, false);
+        offset += it->size();
+        if (list) {
+            if (list == list->next) {
+                list->steiner = true;
+            }
+            holes.push_back(getLeftmost(list));
+        }
+    }
+    if (!holes.empty()) {
+        outerNode = eliminateHoles(holes, outerNode);
+    }
+
+    hashing = outerRing.size() > hashThreshold;
+    if (hashing) {
+        double maxX = outerRing[0].x, maxY = outerRing[0].y;
+        minX = maxX;
+        minY = maxY;
+        for (const auto& point : outerRing) {
+            minX = std::min<double>(minX, point.x);
+            minY = std::min<double>(minY, point.y);
+            maxX = std::max<double>(maxX, point.x);
+            maxY = std::max<double>(maxY, point.y);
+        }
+        const double size = std::max(maxX - minX, maxY - minY);
+        invSize = size != 0 ? 1 / size : 0;
+        hashing = invSize != 0;
+    }
+
+    earcutLinked(outerNode);
+
+    // Compare the area covered by the triangles to the area of the polygon. They only match if
+    // the rings were simple and didn't cross each other.
+    double polygonArea = 0;
+    for (auto it = first; it != last; ++it) {
+        if (it->size() >= 3) {
+            polygonArea += (it == first ? 1 : -1) * std::abs(signedArea(*it));
+        }
+    }
+
+    vertices.clear();
+    for (auto it = first; it != last; ++it) {
+        for (const auto& point : *it) {
+            vertices.push_back(&point);
+        }
+    }
+
+    double trianglesArea = 0;
+    for (std::size_t i = start; i + 2 < indices.size(); i += 3) {
+        const Coordinate& a = *vertices[indices[i]];
+        const Coordinate& b = *vertices[indices[i + 1]];
+        const Coordinate& c = *vertices[indices[i + 2]];
+        trianglesArea += std::abs(double(a.x - c.x) * double(b.y - a.y) - double(a.x - b.x) * double(c.y - a.y));
+    }
+
+    if (polygonArea == 0 && trianglesArea == 0) {
+        return true;
+    }
+    return std::abs(trianglesArea - polygonArea) <= maxDeviation * std::abs(polygonArea);
+}
+
+// Creates a circular doubly linked list from the ring, in the given winding order.
+Earcut::Node* Earcut::linkedList(const std::vector<Coordinate>& ring, uint32_t offset, bool clockwise) {
+    if (ring.empty()) {
+        return nullptr;
+    }
+
+    Node* last = nullptr;
+    if (clockwise == (signedArea(ring) > 0)) {
+        for (uint32_t i = 0; i < ring.size(); i++) {
+            last = insertNode(offset + i, ring[i], last);
+        }
+    } else {
+        for (uint32_t i = ring.size(); i-- > 0;) {
+            last = insertNode(offset + i, ring[i], last);
+        }
+    }
+
+    if (last && equals(last, last->next)) {
+        removeNode(last);
+        last = last->next;
+    }
+
+    return last;
+}
+
+// Eliminates duplicate and collinear points.
+Earcut::Node* Earcut::filterPoints(Node* start, Node* end) {
+    if (!start) {
+        return start;
+    }
+    if (!end) {
+        end = start;
+    }
+
+    Node* p = start;
+    bool again;
+    do {
+        again = false;
+
+        if (!p->steiner && (equals(p, p->next) || area(p->prev, p, p->next) == 0)) {
+            removeNode(p);
+            p = end = p->prev;
+            if (p == p->next) {
+                break;
+            }
+            again = true;
+        } else {
+            p = p->next;
+        }
+    } while (again || p != end);
+
+    return end;
+}
+
+// Clips ears off the ring until only one triangle remains. When no ear can be found, the ring
+// is cleaned up, then its local self-intersections are cured, and as a last resort it is split
+// in two along a diagonal.
+void Earcut::earcutLinked(Node* ear, int pass) {
+    if (!ear) {
+        return;
+    }
+
+    if (!pass && hashing) {
+        indexCurve(ear);
+    }
+
+    Node* stop = ear;
+    while (ear->prev != ear->next) {
+        Node* prev = ear->prev;
+        Node* next = ear->next;
+
+        if (hashing ? isEarHashed(ear) : isEar(ear)) {
+            addTriangle(prev, ear, next);
+            removeNode(ear);
+
+            // Skipping the next vertex leads to less sliver triangles.
+            ear = next->next;
+            stop = next->next;
+            continue;
+        }
+
+        ear = next;
+
+        if (ear == stop) {
+            if (!pass) {
+                earcutLinked(filterPoints(ear), 1);
+            } else if (pass == 1) {
+                earcutLinked(cureLocalIntersections(filterPoints(ear)), 2);
+            } else if (pass == 2) {
+                splitEarcut(ear);
+            }
+            break;
+        }
+    }
+}
+
+bool Earcut::isEar(Node* ear) {
+    const Node* a = ear->prev;
+    const Node* b = ear;
+    const Node* c = ear->next;
+
+    if (area(a, b, c) >= 0) {
+        // Reflex, can't be an ear.
+        return false;
+    }
+
+    // The ear is valid when no other vertex of the ring lies inside of it.
+    for (const Node* p = ear->next->next; p != ear->prev; p = p->next) {
+        if (pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+            area(p->prev, p, p->next) >= 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Earcut::isEarHashed(Node* ear) {
+    const Node* a = ear->prev;
+    const Node* b = ear;
+    const Node* c = ear->next;
+
+    if (area(a, b, c) >= 0) {
+        return false;
+    }
+
+    // Only the vertices within the z-order range of the triangle's bounding box need checking.
+    const double minTX = std::min({ a->x, b->x, c->x });
+    const double minTY = std::min({ a->y, b->y, c->y });
+    const double maxTX = std::max({ a->x, b->x, c->x });
+    const double maxTY = std::max({ a->y, b->y, c->y });
+
+    const int32_t minZ = zOrder(minTX, minTY);
+    const int32_t maxZ = zOrder(maxTX, maxTY);
+
+    auto blocks = [&](const Node* p) {
+        return p != ear->prev && p != ear->next &&
+               pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+               area(p->prev, p, p->next) >= 0;
+    };
+
+    for (const Node* p = ear->prevZ; p && p->z >= minZ; p = p->prevZ) {
+        if (blocks(p)) {
+            return false;
+        }
+    }
+
+    for (const Node* n = ear->nextZ; n && n->z <= maxZ; n = n->nextZ) {
+        if (blocks(n)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Adds a triangle for every pair of adjacent edges that cross, and removes the vertex between
+// them.
+Earcut::Node* Earcut::cureLocalIntersections(Node* start) {
+    Node* p = start;
+    do {
+        Node* a = p->prev;
+        Node* b = p->next->next;
+
+        if (!equals(a, b) && intersects(a, p, p->next, b) && locallyInside(a, b) && locallyInside(b, a)) {
+            addTriangle(a, p, b);
+
+            removeNode(p);
+            removeNode(p->next);
+
+            p = start = b;
+        }
+        p = p->next;
+    } while (p != start);
+
+    return p;
+}
+
+// Splits the ring in two along a valid diagonal and triangulates both halves.
+void Earcut::splitEarcut(Node* start) {
+    Node* a = start;
+    do {
+        Node* b = a->next->next;
+        while (b != a->prev) {
+            if (a->i != b->i && isValidDiagonal(a, b)) {
+                Node* c = splitPolygon(a, b);
+
+                a = filterPoints(a, a->next);
+                c = filterPoints(c, c->next);
+
+                earcutLinked(a);
+                earcutLinked(c);
+                return;
+            }
+            b = b->next;
+        }
+        a = a->next;
+    } while (a != start);
+}
+
+// Links every hole into the outer ring, from left to right, producing a single ring without
+// holes.
+Earcut::Node* Earcut::eliminateHoles(std::vector<Node*>& holes, Node* outerNode) {
+    std::sort(holes.begin(), holes.end(), [](const Node* a, const Node* b) {
+        return a->x < b->x;
+    });
+
+    for (Node* hole : holes) {
+        eliminateHole(hole, outerNode);
+        outerNode = filterPoints(outerNode, outerNode->next);
+    }
+
+    return outerNode;
+}
+
+void Earcut::eliminateHole(Node* hole, Node* outerNode) {
+    outerNode = findHoleBridge(hole, outerNode);
+    if (outerNode) {
+        Node* b = splitPolygon(outerNode, hole);
+        filterPoints(b, b->next);
+    }
+}
+
+// Finds a vertex of the outer ring that can be connected to the leftmost vertex of the hole
+// without crossing any edge.
+Earcut::Node* Earcut::findHoleBridge(Node* hole, Node* outerNode) {
+    Node* p = outerNode;
+    const double hx = hole->x;
+    const double hy = hole->y;
+    double qx = -std::numeric_limits<double>::infinity();
+    Node* m = nullptr;
+
+    // Find the segment of the outer ring to the left of the hole's point that is closest to it,
+    // along a ray from the point to the left.
+    do {
+        if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+            const double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+            if (x <= hx && x > qx) {
+                qx = x;
+                if (x == hx) {
+                    if (hy == p->y) return p;
+                    if (hy == p->next->y) return p->next;
+                }
+                m = p->x < p->next->x ? p : p->next;
+            }
+        }
+        p = p->next;
+    } while (p != outerNode);
+
+    if (!m) {
+        return nullptr;
+    }
+
+    if (hx == qx) {
+        // The hole touches the outer segment; pick its leftmost endpoint.
+        return m->prev;
+    }
+
+    // Look for points inside the triangle of the hole point, the intersection point and the
+    // segment's endpoint. If there are any, connect to the one with the smallest angle to the
+    // ray instead, so that the bridge doesn't cross the outer ring.
+    const Node* stop = m;
+    const double mx = m->x;
+    const double my = m->y;
+    double tanMin = std::numeric_limits<double>::infinity();
+
+    p = m->next;
+    while (p != stop) {
+        if (hx >= p->x && p->x >= mx && hx != p->x &&
+            pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+
+            const double tangent = std::abs(hy - p->y) / (hx - p->x);
+            if ((tangent < tanMin || (tangent == tanMin && p->x > m->x)) && locallyInside(p, hole)) {
+                m = p;
+                tanMin = tangent;
+            }
+        }
+        p = p->next;
+    }
+
+    return m;
+}
+
+// Links the vertices of the ring in z-order.
+void Earcut::indexCurve(Node* start) {
+    Node* p = start;
+    do {
+        p->z = zOrder(p->x, p->y);
+        p->prevZ = p->prev;
+        p->nextZ = p->next;
+        p = p->next;
+    } while (p != start);
+
+    p->prevZ->nextZ = nullptr;
+    p->prevZ = nullptr;
+
+    sortLinked(p);
+}
+
+// Sorts the z-order list with a bottom-up merge sort.
+Earcut::Node* Earcut::sortLinked(Node* list) {
+    int inSize = 1;
+    int numMerges;
+
+    do {
+        Node* p = list;
+        list = nullptr;
+        Node* tail = nullptr;
+        numMerges = 0;
+
+        while (p) {
+            numMerges++;
+            Node* q = p;
+            int pSize = 0;
+            for (int i = 0; i < inSize; i++) {
+                pSize++;
+                q = q->nextZ;
+                if (!q) break;
+            }
+
+            int qSize = inSize;
+
+            while (pSize > 0 || (qSize > 0 && q)) {
+                Node* e;
+                if (pSize != 0 && (qSize == 0 || !q || p->z <= q->z)) {
+                    e = p;
+                    p = p->nextZ;
+                    pSize--;
+                } else {
+                    e = q;
+                    q = q->nextZ;
+                    qSize--;
+                }
+
+                if (tail) {
+                    tail->nextZ = e;
+                } else {
+                    list = e;
+                }
+
+                e->prevZ = tail;
+                tail = e;
+            }
+
+            p = q;
+        }
+
+        tail->nextZ = nullptr;
+        inSize *= 2;
+    } while (numMerges > 1);
+
+    return list;
+}
+
+// Interleaves the bits of the coordinates, normalized to 15 bits within the bounding box.
+int32_t Earcut::zOrder(double x_, double y_) const {
+    int32_t x = 32767 * (x_ - minX) * invSize;
+    int32_t y = 32767 * (y_ - minY) * invSize;
+
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+
+    y = (y | (y << 8)) & 0x00FF00FF;
+    y = (y | (y << 4)) & 0x0F0F0F0F;
+    y = (y | (y << 2)) & 0x33333333;
+    y = (y | (y << 1)) & 0x55555555;
+
+    return x | (y << 1);
+}
+
+Earcut::Node* Earcut::getLeftmost(Node* start) {
+    Node* p = start;
+    Node* leftmost = start;
+    do {
+        if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y)) {
+            leftmost = p;
+        }
+        p = p->next;
+    } while (p != start);
+
+    return leftmost;
+}
+
+// Whether a diagonal between a and b lies within the polygon without crossing any edge.
+bool Earcut::isValidDiagonal(Node* a, Node* b) {
+    return a->next->i != b->i && a->prev->i != b->i && !intersectsPolygon(a, b) &&
+           locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b);
+}
+
+bool Earcut::intersectsPolygon(Node* a, Node* b) {
+    const Node* p = a;
+    do {
+        if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i &&
+            intersects(p, p->next, a, b)) {
+            return true;
+        }
+        p = p->next;
+    } while (p != a);
+
+    return false;
+}
+
+// Whether the middle point of the diagonal from a to b lies inside the polygon.
+bool Earcut::middleInside(Node* a, Node* b) {
+    const Node* p = a;
+    bool inside = false;
+    const double px = (a->x + b->x) / 2;
+    const double py = (a->y + b->y) / 2;
+    do {
+        if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y &&
+            (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x)) {
+            inside = !inside;
+        }
+        p = p->next;
+    } while (p != a);
+
+    return inside;
+}
+
+// Links vertex a to vertex b, splitting the ring in two. If they are in different rings, the
+// rings are merged into one instead. Returns the copy of b in the second ring.
+Earcut::Node* Earcut::splitPolygon(Node* a, Node* b) {
+    nodes.emplace_back(a->i, a->x, a->y);
+    Node* a2 = &nodes.back();
+    nodes.emplace_back(b->i, b->x, b->y);
+    Node* b2 = &nodes.back();
+    Node* an = a->next;
+    Node* bp = b->prev;
+
+    a->next = b;
+    b->prev = a;
+
+    a2->next = an;
+    an->prev = a2;
+
+    b2->next = a2;
+    a2->prev = b2;
+
+    bp->next = b2;
+    b2->prev = bp;
+
+    return b2;
+}
+
+Earcut::Node* Earcut::insertNode(uint32_t i, const Coordinate& point, Node* last) {
+    nodes.emplace_back(i, point.x, point.y);
+    Node* p = &nodes.back();
+
+    if (!last) {
+        p->prev = p;
+        p->next = p;
+    } else {
+        p->next = last->next;
+        p->prev = last;
+        last->next->prev = p;
+        last->next = p;
+    }
+    return p;
+}
+
+void Earcut::removeNode(Node* p) {
+    p->next->prev = p->prev;
+    p->prev->next = p->next;
+
+    if (p->prevZ) {
+        p->prevZ->nextZ = p->nextZ;
+    }
+    if (p->nextZ) {
+        p->nextZ->prevZ = p->prevZ;
+    }
+}
+
+void Earcut::addTriangle(Node* a, Node* b, Node* c) {
+    triangles->push_back(a->i);
+    triangles->push_back(b->i);
+    triangles->push_back(c->i);
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,97 @@
+#ifndef MBGL_UTIL_EARCUT
+#define MBGL_UTIL_EARCUT
+
+#include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+// Triangulates polygons with holes by repeatedly clipping off ears, i.e. triangles formed by
+// three consecutive vertices that contain no other vertex. Holes are first joined to the outer
+// ring through bridges. This is much faster than a sweep-line tessellator for the simple
+// polygons that make up most of a tile, but the result is only correct for polygons whose rings
+// don't intersect. The triangulator is reused across polygons to keep its node storage.
+class Earcut : private util::noncopyable {
+public:
+    // Triangulates the polygon made of the rings [first, last): its outer ring, followed by its
+    // holes. The rings must not repeat their first point at the end. Appends the indices of the
+    // triangles to `indices`, three per triangle, counting the vertices of all rings in order.
+    //
+    // Returns false when the triangles don't exactly cover the area of the polygon, which
+    // happens when its rings intersect each other or themselves.
+    bool operator()(GeometryCollection::const_iterator first,
+                    GeometryCollection::const_iterator last,
+                    std::vector<uint32_t>& indices);
+
+private:
+    struct Node {
+        Node(uint32_t i_, double x_, double y_) : i(i_), x(x_), y(y_) {}
+
+        // Index of the vertex in the input, and its coordinates.
+        const uint32_t i;
+        const double x;
+        const double y;
+
+        // Previous and next vertex of the ring.
+        Node* prev = nullptr;
+        Node* next = nullptr;
+
+        // Previous and next vertex in z-order, and the z-order value.
+        Node* prevZ = nullptr;
+        Node* nextZ = nullptr;
+        int32_t z = 0;
+
+        // Holes that consist of a single point are kept as they are.
+        bool steiner = false;
+    };
+
+    Node* linkedList(const std::vector<Coordinate>& ring, uint32_t offset, bool clockwise);
+    Node* filterPoints(Node* start, Node* end = nullptr);
+    void earcutLinked(Node* ear, int pass = 0);
+    bool isEar(Node* ear);
+    bool isEarHashed(Node* ear);
+    Node* cureLocalIntersections(Node* start);
+    void splitEarcut(Node* start);
+    Node* eliminateHoles(std::vector<Node*>& holes, Node* outerNode);
+    void eliminateHole(Node* hole, Node* outerNode);
+    Node* findHoleBridge(Node* hole, Node* outerNode);
+    void indexCurve(Node* start);
+    Node* sortLinked(Node* list);
+    int32_t zOrder(double x, double y) const;
+    Node* getLeftmost(Node* start);
+    bool isValidDiagonal(Node* a, Node* b);
+    bool intersectsPolygon(Node* a, Node* b);
+    bool middleInside(Node* a, Node* b);
+    Node* splitPolygon(Node* a, Node* b);
+    Node* insertNode(uint32_t i, const Coordinate& point, Node* last);
+    void removeNode(Node* p);
+
+    void addTriangle(Node* a, Node* b, Node* c);
+
+    std::deque<Node> nodes;
+    std::vector<uint32_t>* triangles = nullptr;
+    std::vector<const Coordinate*> vertices;
+
+    // Bounding box of the outer ring, used for z-order hashing of large polygons.
+    bool hashing = false;
+    double minX = 0, minY = 0, invSize = 0;
+};
+
+// Returns twice the signed area of the ring. Its sign tells the winding order of the ring.
+double signedArea(const std::vector<Coordinate>& ring);
+
+// Returns whether the winding of the rings agrees with their nesting, i.e. whether every ring that
+// lies inside the preceding outer ring is wound the other way, and every ring outside of it the
+// same way as the first ring. Vector tiles follow this rule, but GeoJSON and annotations don't
+// have to.
+bool windingMatchesNesting(GeometryCollection::const_iterator first, GeometryCollection::const_iterator last);
+
+} // namespace util
+} // namespace mbgl
+
+#endif
@@ -5,17 +5,47 @@
 
 namespace mbgl {
 
+namespace {
+
+class ScalingGeometryVisitor : public GeometryVisitor {
+public:
+    ScalingGeometryVisitor(GeometryVisitor& visitor_, float scale_)
+        : visitor(visitor_), scale(scale_) {}
+
+    void beginLine() override { visitor.beginLine(); }
+    void endLine() override { visitor.endLine(); }
+
+    void addPoint(const Coordinate& point) override {
+        visitor.addPoint(Coordinate(::round(point.x * scale), ::round(point.y * scale)));
+    }
+
+private:
+    GeometryVisitor& visitor;
+    const float scale;
+};
+
+} // namespace
+
 GeometryCollection getGeometries(const GeometryTileFeature& feature) {
-    const float scale = float(util::EXTENT) / feature.getExtent();
-    GeometryCollection geometryCollection = feature.getGeometries();
-    for (auto& line : geometryCollection) {
-        for (auto& point : line) {
-            point.x = ::round(point.x * scale);
-            point.y = ::round(point.y * scale);
-        }
+    GeometryCollection geometryCollection;
+    GeometryCollectionBuilder builder(geometryCollection);
+    visitGeometries(feature, builder);
+
+    if (geometryCollection.empty()) {
+        geometryCollection.emplace_back();
     }
+
     return geometryCollection;
 }
 
-} // namespace mbgl
+void visitGeometries(const GeometryTileFeature& feature, GeometryVisitor& visitor) {
+    const uint32_t extent = feature.getExtent();
+    if (extent == uint32_t(util::EXTENT)) {
+        feature.visitGeometries(visitor);
+    } else {
+        ScalingGeometryVisitor scaling(visitor, float(util::EXTENT) / extent);
+        feature.visitGeometries(scaling);
+    }
+}
 
+} // namespace mbgl
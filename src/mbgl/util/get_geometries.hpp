@@ -7,6 +7,9 @@ namespace mbgl {
 
 GeometryCollection getGeometries(const GeometryTileFeature& feature);
 
+// Pushes the feature's geometry to the visitor, rescaled from the feature's extent to util::EXTENT.
+void visitGeometries(const GeometryTileFeature& feature, GeometryVisitor& visitor);
+
 } // namespace mbgl
 
 #endif
@@ -9,7 +9,9 @@
  */
 
 #include <string>
+#include <vector>
 #include <cstring>
+#include <cstdint>
 
 namespace mbgl {
 
@@ -30,6 +32,9 @@ struct pbf {
     template <typename T = uint32_t> inline T varint();
     template <typename T = uint32_t> inline T svarint();
 
+    // Decodes all remaining varints of a packed repeated field in one go.
+    template <typename T = uint32_t> inline void varints(std::vector<T>&);
+
     template <typename T = uint32_t, int bytes = 4> inline T fixed();
     inline float float32();
     inline double float64();
@@ -47,6 +52,10 @@ struct pbf {
     const uint8_t *end = nullptr;
     uint32_t value = 0;
     uint32_t tag = 0;
+
+private:
+    template <typename T> inline T slowVarint();
+    static inline uint32_t wordVarint(const uint8_t *data, uint64_t& result);
 };
 
 pbf::pbf(const unsigned char *data_, size_t length)
@@ -88,8 +97,54 @@ bool pbf::next(uint32_t requested_tag) {
     return false;
 }
 
+// Decodes a varint of up to eight bytes from a single unaligned word, using bit operations on the
+// whole word instead of a loop with a branch per byte. The caller must ensure that eight bytes are
+// readable. Returns the number of bytes consumed, or 0 if the varint is longer than eight bytes.
+uint32_t pbf::wordVarint(const uint8_t *data, uint64_t& result) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+
+    // The last byte of a varint is the first one without its continuation bit set.
+    const uint64_t stop = ~word & 0x8080808080808080ULL;
+    if (!stop) {
+        return 0;
+    }
+    const uint64_t last = stop & (~stop + 1);
+
+    // Drop the bytes following the varint and the continuation bits, then pack the 7-bit groups.
+    word &= ((last << 1) - 1) & 0x7F7F7F7F7F7F7F7FULL;
+    word = (word & 0x007F007F007F007FULL) | ((word & 0x7F007F007F007F00ULL) >> 1);
+    word = (word & 0x00003FFF00003FFFULL) | ((word & 0x3FFF00003FFF0000ULL) >> 2);
+    word = (word & 0x000000000FFFFFFFULL) | ((word & 0x0FFFFFFF00000000ULL) >> 4);
+
+    result = word;
+    return (__builtin_ctzll(stop) >> 3) + 1;
+#else
+    (void)data;
+    (void)result;
+    return 0;
+#endif
+}
+
 template <typename T>
 T pbf::varint() {
+    // Most varints in tiles are a single byte.
+    if (data < end && !(*data & 0x80)) {
+        return static_cast<T>(*data++);
+    }
+    if (end - data >= 8) {
+        uint64_t result;
+        if (const uint32_t bytes = wordVarint(data, result)) {
+            data += bytes;
+            return static_cast<T>(result);
+        }
+    }
+    return slowVarint<T>();
+}
+
+template <typename T>
+T pbf::slowVarint() {
     uint8_t byte = 0x80;
     T result = 0;
     int bitpos;
@@ -108,6 +163,28 @@ T pbf::varint() {
     return result;
 }
 
+template <typename T>
+void pbf::varints(std::vector<T>& result) {
+    // Every varint is at least one byte long.
+    result.reserve(result.size() + (end - data));
+
+    uint64_t value_;
+    while (end - data >= 8) {
+        if (!(*data & 0x80)) {
+            result.push_back(static_cast<T>(*data++));
+        } else if (const uint32_t bytes = wordVarint(data, value_)) {
+            data += bytes;
+            result.push_back(static_cast<T>(value_));
+        } else {
+            result.push_back(slowVarint<T>());
+        }
+    }
+
+    while (data < end) {
+        result.push_back(slowVarint<T>());
+    }
+}
+
 template <typename T>
 T pbf::svarint() {
     T n = varint<T>();
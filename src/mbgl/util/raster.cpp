@@ -25,6 +25,11 @@ bool Raster::isLoaded() const {
     return loaded;
 }
 
+std::size_t Raster::getByteSize() const {
+    const std::size_t imageSize = std::size_t(width) * height * 4;
+    return (img.data ? imageSize : 0) + (textured ? imageSize : 0);
+}
+
 void Raster::load(PremultipliedImage image) {
     assert(image.data.get());
 
@@ -29,6 +29,9 @@ public:
     // loaded status
     bool isLoaded() const;
 
+    // bytes used by the raw pixels and the uploaded texture
+    std::size_t getByteSize() const;
+
 public:
     // loaded image dimensions
     GLsizei width = 0;
@@ -0,0 +1,197 @@
+#include <mbgl/util/simplify.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+std::atomic<uint64_t> simplifiedVertexCount { 0 };
+std::atomic<uint64_t> removedVertexCount { 0 };
+
+// Computes squared distances from the segment between two points.
+class SegmentDistance {
+public:
+    SegmentDistance(const Coordinate& a, const Coordinate& b)
+        : x(a.x), y(a.y), dx(b.x - a.x), dy(b.y - a.y) {
+        const double sqLength = dx * dx + dy * dy;
+        invSqLength = sqLength > 0 ? 1 / sqLength : 0;
+    }
+
+    double operator()(const Coordinate& p) const {
+        const double px = p.x - x;
+        const double py = p.y - y;
+        const double t = std::min(std::max((px * dx + py * dy) * invSqLength, 0.0), 1.0);
+        const double ex = px - dx * t;
+        const double ey = py - dy * t;
+        return ex * ex + ey * ey;
+    }
+
+private:
+    const double x, y, dx, dy;
+    double invSqLength;
+};
+
+// Twice the signed area of the ring [first, last), with the same sign as signedArea().
+template <typename Iterator>
+double ringArea(Iterator first, Iterator last) {
+    double sum = 0;
+    for (Iterator i = first, j = std::prev(last); i != last; j = i++) {
+        sum += double(j->x - i->x) * double(i->y + j->y);
+    }
+    return sum;
+}
+
+} // namespace
+
+Simplifier::Simplifier(double tolerance_)
+    : sqTolerance(tolerance_ * tolerance_) {
+}
+
+Simplifier::~Simplifier() {
+    if (vertices) {
+        simplifiedVertexCount += vertices;
+        removedVertexCount += removedVertices;
+    }
+}
+
+double Simplifier::tolerance(float pixels, float overscaling) {
+    return pixels * util::EXTENT / (2 * util::tileSize * overscaling);
+}
+
+Simplifier::Stats Simplifier::getStats() {
+    Stats stats;
+    stats.vertices = simplifiedVertexCount;
+    stats.removedVertices = removedVertexCount;
+    return stats;
+}
+
+void Simplifier::simplify(const std::vector<Coordinate>& points, std::size_t first, std::size_t last) {
+    const std::size_t size = points.size();
+
+    stack.clear();
+    stack.emplace_back(first, last);
+
+    while (!stack.empty()) {
+        const auto segment = stack.back();
+        stack.pop_back();
+
+        // Only the last index of a ring can wrap around.
+        const SegmentDistance sqSegmentDistance(points[segment.first],
+                                                points[segment.second < size ? segment.second : 0]);
+
+        double maxSqDistance = sqTolerance;
+        std::size_t index = 0;
+
+        for (std::size_t i = segment.first + 1; i < segment.second; i++) {
+            const double sqDistance = sqSegmentDistance(points[i]);
+            if (sqDistance > maxSqDistance) {
+                maxSqDistance = sqDistance;
+                index = i;
+            }
+        }
+
+        if (index) {
+            keep[index] = true;
+            stack.emplace_back(segment.first, index);
+            stack.emplace_back(index, segment.second);
+        }
+    }
+}
+
+void Simplifier::simplifyLine(const std::vector<Coordinate>& line, std::vector<Coordinate>& output) {
+    if (line.size() <= 2) {
+        output.insert(output.end(), line.begin(), line.end());
+        return;
+    }
+
+    keep.assign(line.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+    simplify(line, 0, line.size() - 1);
+
+    const std::size_t begin = output.size();
+    for (std::size_t i = 0; i < line.size(); i++) {
+        if (keep[i]) {
+            output.push_back(line[i]);
+        }
+    }
+
+    vertices += line.size();
+    removedVertices += line.size() - (output.size() - begin);
+}
+
+bool Simplifier::simplifyRing(const std::vector<Coordinate>& ring, std::vector<Coordinate>& output) {
+    const std::size_t size = ring.size();
+    if (size <= 3) {
+        output.insert(output.end(), ring.begin(), ring.end());
+        return true;
+    }
+
+    // Rings have no end points, so they are split at their first vertex and the vertex that
+    // is farthest from it.
+    std::size_t far = 0;
+    double maxSqDistance = 0;
+    for (std::size_t i = 1; i < size; i++) {
+        const double dx = ring[i].x - ring[0].x;
+        const double dy = ring[i].y - ring[0].y;
+        if (dx * dx + dy * dy > maxSqDistance) {
+            maxSqDistance = dx * dx + dy * dy;
+            far = i;
+        }
+    }
+
+    keep.assign(size, false);
+    keep[0] = true;
+    keep[far] = true;
+    simplify(ring, 0, far);
+    simplify(ring, far, size);
+
+    const std::size_t begin = output.size();
+    for (std::size_t i = 0; i < size; i++) {
+        if (keep[i]) {
+            output.push_back(ring[i]);
+        }
+    }
+
+    vertices += size;
+
+    const std::size_t kept = output.size() - begin;
+    if (kept >= 3) {
+        const double area = ringArea(ring.begin(), ring.end());
+        const double simplifiedArea = ringArea(output.begin() + begin, output.end());
+        if ((simplifiedArea > 0) == (area > 0) && simplifiedArea != 0) {
+            removedVertices += size - kept;
+            return true;
+        }
+    }
+
+    output.resize(begin);
+
+    // The ring collapsed or turned inside out. Drop it if it is too small to see.
+    int32_t minX = ring[0].x, maxX = ring[0].x;
+    int32_t minY = ring[0].y, maxY = ring[0].y;
+    for (const auto& point : ring) {
+        minX = std::min<int32_t>(minX, point.x);
+        maxX = std::max<int32_t>(maxX, point.x);
+        minY = std::min<int32_t>(minY, point.y);
+        maxY = std::max<int32_t>(maxY, point.y);
+    }
+
+    const double maxSize = std::sqrt(sqTolerance);
+    if (maxX - minX <= maxSize && maxY - minY <= maxSize) {
+        removedVertices += size;
+        return false;
+    }
+
+    output.insert(output.end(), ring.begin(), ring.end());
+    return true;
+}
+
+} // namespace util
+} // namespace mbgl
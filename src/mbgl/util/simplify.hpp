@@ -0,0 +1,69 @@
+#ifndef MBGL_UTIL_SIMPLIFY
+#define MBGL_UTIL_SIMPLIFY
+
+#include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+// Removes the vertices of lines and polygon rings that deviate less than a tolerance from the
+// simplified shape, using the Douglas-Peucker algorithm. Low zoom and overscaled tiles often
+// carry far more vertices than their pixels can show. Buckets keep one simplifier for all of
+// their features, so that it reuses its scratch storage.
+class Simplifier : private util::noncopyable {
+public:
+    // The tolerance is in tile units. A tolerance of zero disables simplification.
+    explicit Simplifier(double tolerance = 0);
+    ~Simplifier();
+
+    // Returns the tolerance in tile units that corresponds to the given number of pixels on a
+    // tile that is drawn at the given overscaling factor. Tiles are shown at up to twice their
+    // size before the next zoom level replaces them.
+    static double tolerance(float pixels, float overscaling);
+
+    explicit operator bool() const {
+        return sqTolerance > 0;
+    }
+
+    // Appends the simplified line to `output`. The first and last points are always kept.
+    void simplifyLine(const std::vector<Coordinate>& line, std::vector<Coordinate>& output);
+
+    // Appends the simplified ring to `output`. The ring must not repeat its first point at the
+    // end. Rings keep at least three vertices and their winding order; those that can't are
+    // kept as they are, unless they are smaller than the tolerance in both directions. Returns
+    // false for such rings, which should be dropped, and leaves `output` unchanged.
+    bool simplifyRing(const std::vector<Coordinate>& ring, std::vector<Coordinate>& output);
+
+    // Vertices that were simplified and vertices that were removed as a result, counted across
+    // all simplifiers in this process.
+    struct Stats {
+        uint64_t vertices = 0;
+        uint64_t removedVertices = 0;
+    };
+
+    static Stats getStats();
+
+private:
+    // Marks the vertices between first and last that are kept. A last index of points.size()
+    // refers to the first point.
+    void simplify(const std::vector<Coordinate>& points, std::size_t first, std::size_t last);
+
+    const double sqTolerance;
+
+    std::vector<bool> keep;
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+
+    // Flushed to the process-wide stats when the simplifier is destroyed.
+    uint64_t vertices = 0;
+    uint64_t removedVertices = 0;
+};
+
+} // namespace util
+} // namespace mbgl
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef MBGL_UTIL_THREAD_POOL
+#define MBGL_UTIL_THREAD_POOL
+
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_context.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+// A fixed set of threads sharing one queue of work. Idle threads take the queued task with
+// the lowest WorkTask::getPriority() value, and among equal priorities the oldest one, so
+// a single long running task only occupies one thread while the remaining work continues
+// in priority order on the others.
+//
+// Unlike util::Thread<>, pool threads don't have a RunLoop: tasks must not rely on
+// RunLoop::Get() while executing.
+
+class ThreadPool : private util::noncopyable {
+public:
+    ThreadPool(const ThreadContext&, std::size_t count);
+    ~ThreadPool();
+
+    // Invoke fn(args...) on one of the pool threads, then invoke callback(results...) on
+    // the current RunLoop. See RunLoop::invokeWithCallback for the request semantics.
+    template <class Fn, class Cb, class... Args>
+    std::unique_ptr<WorkRequest>
+    invokeWithCallback(Fn&& fn, Cb&& callback, Args&&... args) {
+        return invokeWithPriority(0, std::move(fn), std::move(callback), std::move(args)...);
+    }
+
+    // Like invokeWithCallback, but queues the task with the given priority, which the returned
+    // request can change later.
+    template <class Fn, class Cb, class... Args>
+    std::unique_ptr<WorkRequest>
+    invokeWithPriority(int32_t priority, Fn&& fn, Cb&& callback, Args&&... args) {
+        auto task = RunLoop::makeTaskWithCallback(std::move(fn), std::move(callback), std::move(args)...);
+
+        schedule(task, priority);
+
+        return std::make_unique<WorkRequest>(task);
+    }
+
+    std::size_t size() const { return threads.size(); }
+
+private:
+    struct Entry {
+        std::shared_ptr<WorkTask> task;
+        uint64_t sequence;
+    };
+
+    void schedule(std::shared_ptr<WorkTask>, int32_t priority);
+    void run(ThreadContext);
+    std::shared_ptr<WorkTask> take();
+
+    std::vector<std::thread> threads;
+
+    // Tasks that are queued but not yet taken by a thread, in no particular order. Priorities
+    // may change while tasks are queued, so the queue is scanned for the next task rather
+    // than kept sorted.
+    std::vector<Entry> queue;
+    uint64_t sequence = 0;
+    bool terminating = false;
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+} // namespace util
+} // namespace mbgl
+
+#endif
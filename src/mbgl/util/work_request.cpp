@@ -14,4 +14,8 @@ WorkRequest::~WorkRequest() {
     task->cancel();
 }
 
+void WorkRequest::setPriority(int32_t priority) {
+    task->setPriority(priority);
+}
+
 } // namespace mbgl
@@ -1,4 +1,5 @@
 #include <mbgl/util/worker.hpp>
+#include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/work_task.hpp>
 #include <mbgl/util/work_request.hpp>
 #include <mbgl/platform/platform.hpp>
@@ -11,6 +12,19 @@
 
 namespace mbgl {
 
+namespace {
+
+// Pool threads don't own an object, so bind it to each request instead. The pool may be
+// shared with other Workers and outlive this one, so requests hold on to the object.
+template <typename Object, typename Fn>
+auto bind(std::shared_ptr<Object> object, Fn fn) {
+    return [object, fn] (auto&&... args) {
+        return ((*object).*fn)(std::forward<decltype(args)>(args)...);
+    };
+}
+
+} // namespace
+
 class Worker::Impl {
 public:
     Impl() = default;
@@ -53,17 +67,20 @@ public:
     void redoPlacement(TileWorker* worker,
                        const std::unordered_map<std::string, std::unique_ptr<Bucket>>* buckets,
                        PlacementConfig config,
-                       std::function<void()> callback) {
-        worker->redoPlacement(buckets, config);
-        callback();
+                       NeighbourBoxes neighbours,
+                       std::function<void(std::shared_ptr<const BorderBoxes>)> callback) {
+        callback(worker->redoPlacement(buckets, config, neighbours));
     }
 };
 
-Worker::Worker(std::size_t count) {
-    util::ThreadContext context = { "Worker", util::ThreadType::Worker, util::ThreadPriority::Low };
-    for (std::size_t i = 0; i < count; i++) {
-        threads.emplace_back(std::make_unique<util::Thread<Impl>>(context));
-    }
+Worker::Worker(std::size_t count)
+    : Worker(std::make_shared<WorkerPool>(count)) {
+}
+
+Worker::Worker(std::shared_ptr<WorkerPool> pool_)
+    : impl(std::make_shared<Impl>()),
+      pool(std::move(pool_)) {
+    assert(pool);
 }
 
 Worker::~Worker() = default;
@@ -71,10 +88,10 @@ Worker::~Worker() = default;
 std::unique_ptr<WorkRequest>
 Worker::parseRasterTile(std::unique_ptr<RasterBucket> bucket,
                         const std::shared_ptr<const std::string> data,
+                        int32_t priority,
                         std::function<void(RasterTileParseResult)> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::parseRasterTile, callback, bucket,
-                                                data);
+    return pool->threads->invokeWithPriority(priority, bind(impl, &Worker::Impl::parseRasterTile), callback,
+                                             bucket, data);
 }
 
 std::unique_ptr<WorkRequest>
@@ -82,29 +99,30 @@ Worker::parseGeometryTile(TileWorker& worker,
                           std::vector<std::unique_ptr<StyleLayer>> layers,
                           std::unique_ptr<GeometryTile> tile,
                           PlacementConfig config,
+                          int32_t priority,
                           std::function<void(TileParseResult)> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::parseGeometryTile, callback, &worker,
-                                                std::move(layers), std::move(tile), config);
+    return pool->threads->invokeWithPriority(priority, bind(impl, &Worker::Impl::parseGeometryTile), callback,
+                                             &worker, std::move(layers), std::move(tile), config);
 }
 
 std::unique_ptr<WorkRequest>
 Worker::parsePendingGeometryTileLayers(TileWorker& worker,
                                        PlacementConfig config,
+                                       int32_t priority,
                                        std::function<void(TileParseResult)> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::parsePendingGeometryTileLayers,
-                                                callback, &worker, config);
+    return pool->threads->invokeWithPriority(priority, bind(impl, &Worker::Impl::parsePendingGeometryTileLayers),
+                                             callback, &worker, config);
 }
 
 std::unique_ptr<WorkRequest>
 Worker::redoPlacement(TileWorker& worker,
                       const std::unordered_map<std::string, std::unique_ptr<Bucket>>& buckets,
                       PlacementConfig config,
-                      std::function<void()> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::redoPlacement, callback, &worker,
-                                                &buckets, config);
+                      NeighbourBoxes neighbours,
+                      int32_t priority,
+                      std::function<void(std::shared_ptr<const BorderBoxes>)> callback) {
+    return pool->threads->invokeWithPriority(priority, bind(impl, &Worker::Impl::redoPlacement), callback,
+                                             &worker, &buckets, config, std::move(neighbours));
 }
 
 } // end namespace mbgl
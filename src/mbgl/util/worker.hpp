@@ -2,7 +2,7 @@
 #define MBGL_UTIL_WORKER
 
 #include <mbgl/util/noncopyable.hpp>
-#include <mbgl/util/thread.hpp>
+#include <mbgl/util/worker_pool.hpp>
 #include <mbgl/tile/tile_worker.hpp>
 
 #include <functional>
@@ -20,7 +20,9 @@ using RasterTileParseResult = mapbox::util::variant<
 
 class Worker : public mbgl::util::noncopyable {
 public:
+    // Creates a pool of its own with the given number of threads.
     explicit Worker(std::size_t count);
+    explicit Worker(std::shared_ptr<WorkerPool>);
     ~Worker();
 
     // Request work be done on a thread pool. Callbacks are executed on the invoking
@@ -32,32 +34,39 @@ public:
     // Together, this means that an object may make a work request with lambdas which
     // bind references to itself, and if and when those lambdas execute, the references
     // will still be valid.
+    //
+    // Jobs with lower priority values are run first, see WorkRequest::setPriority.
 
     using Request = std::unique_ptr<WorkRequest>;
 
     Request parseRasterTile(std::unique_ptr<RasterBucket> bucket,
                             std::shared_ptr<const std::string> data,
+                            int32_t priority,
                             std::function<void(RasterTileParseResult)> callback);
 
     Request parseGeometryTile(TileWorker&,
                               std::vector<std::unique_ptr<StyleLayer>>,
                               std::unique_ptr<GeometryTile>,
                               PlacementConfig,
+                              int32_t priority,
                               std::function<void(TileParseResult)> callback);
 
     Request parsePendingGeometryTileLayers(TileWorker&,
                                            PlacementConfig config,
+                                           int32_t priority,
                                            std::function<void(TileParseResult)> callback);
 
     Request redoPlacement(TileWorker&,
                           const std::unordered_map<std::string, std::unique_ptr<Bucket>>&,
                           PlacementConfig config,
-                          std::function<void()> callback);
+                          NeighbourBoxes,
+                          int32_t priority,
+                          std::function<void(std::shared_ptr<const BorderBoxes>)> callback);
 
 private:
     class Impl;
-    std::vector<std::unique_ptr<util::Thread<Impl>>> threads;
-    std::size_t current = 0;
+    const std::shared_ptr<Impl> impl;
+    const std::shared_ptr<WorkerPool> pool;
 };
 } // namespace mbgl
 
@@ -0,0 +1,44 @@
+#include <mbgl/util/worker_pool.hpp>
+#include <mbgl/util/thread_pool.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+namespace mbgl {
+
+namespace {
+
+std::size_t hardwareThreadCount() {
+    // hardware_concurrency() may return 0 when the count cannot be determined.
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+} // namespace
+
+WorkerPool::WorkerPool(std::size_t threadCount)
+    : threads(std::make_unique<util::ThreadPool>(
+        util::ThreadContext{ "Worker", util::ThreadType::Worker, util::ThreadPriority::Low },
+        threadCount ? threadCount : hardwareThreadCount())) {
+}
+
+WorkerPool::~WorkerPool() = default;
+
+std::size_t WorkerPool::getThreadCount() const {
+    return threads->size();
+}
+
+std::shared_ptr<WorkerPool> WorkerPool::getShared() {
+    static std::mutex mutex;
+    static std::weak_ptr<WorkerPool> shared;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto pool = shared.lock();
+    if (!pool) {
+        pool = std::make_shared<WorkerPool>();
+        shared = pool;
+    }
+    return pool;
+}
+
+} // namespace mbgl
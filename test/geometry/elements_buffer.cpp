@@ -0,0 +1,66 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/geometry/elements_buffer.hpp>
+
+#include <array>
+
+using namespace mbgl;
+
+namespace {
+
+class TestTriangleElementsBuffer : public TriangleElementsBuffer {
+public:
+    using TriangleElementsBuffer::TriangleElementsBuffer;
+
+    std::array<uint32_t, 3> get(size_t i) {
+        const uint32_t* elements = static_cast<const uint32_t*>(getElement(i));
+        return {{ elements[0], elements[1], elements[2] }};
+    }
+};
+
+} // namespace
+
+TEST(ElementsBuffer, ShortIndices) {
+    TriangleElementsBuffer triangles(false);
+    EXPECT_EQ(GLenum(GL_UNSIGNED_SHORT), triangles.getElementType());
+    EXPECT_EQ(6u, triangles.getItemSize());
+    EXPECT_EQ(65535, triangles.maxGroupVertices());
+
+    triangles.add(0, 1, 2);
+    triangles.add(1, 2, 3);
+    EXPECT_EQ(2, triangles.index());
+
+    LineElementsBuffer lines(false);
+    EXPECT_EQ(4u, lines.getItemSize());
+    lines.add(0, 1);
+    EXPECT_EQ(1, lines.index());
+}
+
+TEST(ElementsBuffer, IntIndices) {
+    TestTriangleElementsBuffer triangles(true);
+    EXPECT_GT(triangles.maxGroupVertices(), 65535);
+
+    // Indices stay 16 bits wide as long as they fit.
+    triangles.add(0, 1, 65535);
+    EXPECT_EQ(GLenum(GL_UNSIGNED_SHORT), triangles.getElementType());
+    EXPECT_EQ(6u, triangles.getItemSize());
+
+    triangles.add(0, 70000, 140000);
+    EXPECT_EQ(GLenum(GL_UNSIGNED_INT), triangles.getElementType());
+    EXPECT_EQ(12u, triangles.getItemSize());
+    EXPECT_EQ(2, triangles.index());
+
+    // Widening keeps the indices that were added before.
+    triangles.add(1, 2, 3);
+    EXPECT_EQ(3, triangles.index());
+    EXPECT_EQ((std::array<uint32_t, 3>{{ 0, 1, 65535 }}), triangles.get(0));
+    EXPECT_EQ((std::array<uint32_t, 3>{{ 0, 70000, 140000 }}), triangles.get(1));
+    EXPECT_EQ((std::array<uint32_t, 3>{{ 1, 2, 3 }}), triangles.get(2));
+
+    LineElementsBuffer lines(true);
+    lines.add(0, 1);
+    lines.add(0, 70000);
+    EXPECT_EQ(GLenum(GL_UNSIGNED_INT), lines.getElementType());
+    EXPECT_EQ(8u, lines.getItemSize());
+    EXPECT_EQ(2, lines.index());
+}
@@ -0,0 +1,77 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/geometry/circle_buffer.hpp>
+#include <mbgl/geometry/fill_buffer.hpp>
+#include <mbgl/geometry/icon_buffer.hpp>
+#include <mbgl/geometry/line_buffer.hpp>
+#include <mbgl/geometry/text_buffer.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cstring>
+
+using namespace mbgl;
+
+namespace {
+
+template <class B>
+class RawBuffer : public B {
+public:
+    template <class T>
+    T get(size_t i, size_t offset) {
+        T value;
+        std::memcpy(&value, static_cast<const char*>(this->getElement(i)) + offset, sizeof(T));
+        return value;
+    }
+};
+
+} // namespace
+
+TEST(VertexBuffers, BytesPerVertex) {
+    EXPECT_EQ(4u, FillVertexBuffer().getItemSize());
+    EXPECT_EQ(4u, CircleVertexBuffer().getItemSize());
+    EXPECT_EQ(8u, LineVertexBuffer().getItemSize());
+    EXPECT_EQ(16u, TextVertexBuffer().getItemSize());
+    EXPECT_EQ(16u, IconVertexBuffer().getItemSize());
+}
+
+// The values below are the largest each attribute has to hold. Every field comes close to the
+// range of its type, so none of the layouts can be narrowed without losing precision.
+
+TEST(VertexBuffers, LineFieldsUseTheirFullWidth) {
+    RawBuffer<LineVertexBuffer> line;
+    line.add(util::EXTENT, util::EXTENT, -1, 1, true, false, -1, 8191);
+
+    // Positions at the tile edge take 15 bits once the texture normals are packed in.
+    EXPECT_EQ(2 * util::EXTENT + 1, line.get<int16_t>(0, 0));
+    EXPECT_EQ(2 * util::EXTENT, line.get<int16_t>(0, 2));
+
+    // Extrusion normals take the full signed byte, and direction plus distance two bytes.
+    EXPECT_EQ(-63, line.get<int8_t>(0, 4));
+    EXPECT_EQ(63, line.get<int8_t>(0, 5));
+    EXPECT_EQ(-127, line.get<int8_t>(0, 6));
+    EXPECT_EQ(127, line.get<int8_t>(0, 7));
+}
+
+TEST(VertexBuffers, SymbolFieldsUseTheirFullWidth) {
+    RawBuffer<TextVertexBuffer> text;
+    // A glyph of a long label, 300px left of its anchor at the tile edge, at the far corner of
+    // the 1024px glyph atlas, shown up to the maximum zoom level.
+    text.add(util::EXTENT, util::EXTENT, -300, 300, 1020, 1020, 24, 25, 24);
+
+    EXPECT_EQ(util::EXTENT, text.get<int16_t>(0, 0));
+    EXPECT_EQ(-300 * 64, text.get<int16_t>(0, 4));
+    EXPECT_EQ(300 * 64, text.get<int16_t>(0, 6));
+    EXPECT_EQ(255, text.get<uint8_t>(0, 8));
+    EXPECT_EQ(255, text.get<uint8_t>(0, 9));
+    EXPECT_EQ(240, text.get<uint8_t>(0, 10));
+    EXPECT_EQ(240, text.get<uint8_t>(0, 12));
+    EXPECT_EQ(250, text.get<uint8_t>(0, 13));
+
+    RawBuffer<IconVertexBuffer> icon;
+    icon.add(util::EXTENT, util::EXTENT, -300, 300, 1020, 1020, 24, 25, 24);
+
+    EXPECT_EQ(util::EXTENT, icon.get<int16_t>(0, 0));
+    EXPECT_EQ(-300 * 64, icon.get<int16_t>(0, 4));
+    EXPECT_EQ(255, icon.get<uint8_t>(0, 8));
+    EXPECT_EQ(250, icon.get<uint8_t>(0, 13));
+}
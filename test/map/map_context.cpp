@@ -6,6 +6,7 @@
 #include <mbgl/platform/default/headless_display.hpp>
 #include <mbgl/storage/online_file_source.hpp>
 #include <mbgl/util/thread.hpp>
+#include <mbgl/util/worker_pool.hpp>
 
 using namespace mbgl;
 
@@ -15,7 +16,8 @@ TEST(MapContext, DoubleStyleLoad) {
     OnlineFileSource fileSource;
 
     util::Thread<MapContext> context({"Map", util::ThreadType::Map, util::ThreadPriority::Regular},
-        view, fileSource, MapMode::Continuous, GLContextMode::Unique, view.getPixelRatio());
+        view, fileSource, MapMode::Continuous, GLContextMode::Unique, view.getPixelRatio(),
+        std::make_shared<WorkerPool>(1));
 
     context.invokeSync(&MapContext::setStyleJSON, "", "");
     context.invokeSync(&MapContext::setStyleJSON, "", "");
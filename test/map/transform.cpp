@@ -231,3 +231,42 @@ TEST(Transform, Padding) {
     ASSERT_DOUBLE_EQ(manualShiftedCenter.latitude, shiftedCenter.latitude);
     ASSERT_DOUBLE_EQ(manualShiftedCenter.longitude, shiftedCenter.longitude);
 }
+
+TEST(Transform, TransitionPath) {
+    MockView view;
+    Transform transform(view, ConstrainMode::HeightOnly);
+    transform.resize({{ 1000, 1000 }});
+    transform.setLatLngZoom({ 0, 0 }, 4);
+
+    CameraOptions camera;
+    camera.center = LatLng { 10, 20 };
+    camera.zoom = 8.0;
+
+    AnimationOptions animation;
+    animation.duration = Seconds(1);
+
+    // The path is only sampled when prefetching is enabled.
+    transform.flyTo(camera, animation);
+    ASSERT_TRUE(transform.inTransition());
+    ASSERT_EQ(nullptr, transform.getTransitionPath());
+
+    transform.setPrefetchTransitions(true);
+    transform.flyTo(camera, animation);
+    auto path = transform.getTransitionPath();
+    ASSERT_NE(nullptr, path);
+    ASSERT_FALSE(path->empty());
+
+    // Sampling doesn't move the camera, and the path ends at the destination.
+    ASSERT_DOUBLE_EQ(4, transform.getZoom());
+    ASSERT_NEAR(8, path->back().getZoom(), 1e-6);
+    ASSERT_NEAR(10, path->back().getLatLng().latitude, 1e-6);
+    ASSERT_NEAR(20, path->back().getLatLng().longitude, 1e-6);
+
+    // The path is dropped when the transition is interrupted.
+    transform.cancelTransitions();
+    ASSERT_EQ(nullptr, transform.getTransitionPath());
+
+    // Transitions without an animation have no path.
+    transform.jumpTo(camera);
+    ASSERT_EQ(nullptr, transform.getTransitionPath());
+}
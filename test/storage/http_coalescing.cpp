@@ -0,0 +1,67 @@
+#include "storage.hpp"
+
+#include <mbgl/storage/online_file_source.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+TEST_F(Storage, HTTPCoalescing) {
+    SCOPED_TEST(HTTPCoalescing)
+
+    using namespace mbgl;
+
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/coalesce?HTTPCoalescing" };
+
+    // Identical requests that are in flight at the same time share one response, so the
+    // server sees the URL exactly once.
+    const int total = 3;
+    int responses = 0;
+    std::unique_ptr<FileRequest> reqs[total];
+
+    for (int i = 0; i < total; i++) {
+        reqs[i] = fs.request(resource, [&, i](Response res) {
+            reqs[i].reset();
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("Response 1", *res.data);
+
+            if (++responses == total) {
+                loop.stop();
+                HTTPCoalescing.finish();
+            }
+        });
+    }
+
+    loop.run();
+}
+
+TEST_F(Storage, HTTPCoalescingCancel) {
+    SCOPED_TEST(HTTPCoalescingCancel)
+
+    using namespace mbgl;
+
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/coalesce?HTTPCoalescingCancel" };
+
+    std::unique_ptr<FileRequest> req1 = fs.request(resource, [&](Response) {
+        ADD_FAILURE() << "Should never be called";
+    });
+
+    std::unique_ptr<FileRequest> req2 = fs.request(resource, [&](Response res) {
+        req2.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("Response 1", *res.data);
+        loop.stop();
+        HTTPCoalescingCancel.finish();
+    });
+
+    // Cancelling one of the requests doesn't cancel the response for the other, nor does it
+    // make the other request fetch the URL again.
+    req1.reset();
+
+    loop.run();
+}
@@ -117,6 +117,15 @@ app.get('/delayed', function(req, res) {
     }, 200);
 });
 
+// Counts requests per query string, so that every test can use a counter of its own.
+var coalesceCounters = {};
+app.get('/coalesce', function(req, res) {
+    var query = req.originalUrl;
+    var counter = coalesceCounters[query] = (coalesceCounters[query] || 0) + 1;
+    setTimeout(function() {
+        res.status(200).send('Response ' + counter);
+    }, 200);
+});
 
 app.get('/load/:number(\\d+)', function(req, res) {
     res.send('Request ' + req.params.number);
@@ -5,6 +5,7 @@
 #include <mbgl/text/font_stack.hpp>
 #include <mbgl/text/glyph_store.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_context.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/platform/log.hpp>
@@ -5,6 +5,7 @@
 
 #include <mbgl/source/source.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_context.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/platform/log.hpp>
@@ -13,10 +14,14 @@
 #include <mbgl/map/map_data.hpp>
 #include <mbgl/util/worker.hpp>
 #include <mbgl/gl/texture_pool.hpp>
+#include <mbgl/tile/tile_cache.hpp>
+#include <mbgl/tile/tile.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/style_update_parameters.hpp>
 #include <mbgl/layer/line_layer.hpp>
 
+#include <set>
+
 using namespace mbgl;
 
 class SourceTest {
@@ -30,7 +35,8 @@ public:
     TransformState transformState;
     Worker worker { 1 };
     gl::TexturePool texturePool;
-    MapData mapData { MapMode::Still, GLContextMode::Unique, 1.0 };
+    TileCache tileCache;
+    MapData mapData { MapMode::Still, GLContextMode::Unique, 1.0, std::make_shared<WorkerPool>(1) };
     Style style { mapData, fileSource };
 
     StyleUpdateParameters updateParameters {
@@ -38,9 +44,11 @@ public:
         MapDebugOptions(),
         TimePoint(),
         transformState,
+        nullptr,
         worker,
         fileSource,
         texturePool,
+        tileCache,
         true,
         MapMode::Continuous,
         mapData,
@@ -346,3 +354,112 @@ TEST(Source, VectorTileCancel) {
 
     test.run();
 }
+
+namespace {
+
+std::set<TileID> tilesAtZoom(const Source& source, int8_t z) {
+    std::set<TileID> result;
+    for (const auto tile : source.getTiles()) {
+        if (tile->id.z == z) {
+            result.insert(tile->id);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(Source, CoverFollowsNorthOrientation) {
+    SourceTest test;
+
+    test.fileSource.tileResponse = [&] (const Resource&) {
+        return optional<Response>();
+    };
+
+    // A wide viewport, so that turning the map sideways covers different tiles.
+    test.transform.resize({{ 1536, 256 }});
+    test.transform.setLatLngZoom({ 0, 0 }, 2);
+    test.transformState = test.transform.getState();
+
+    auto info = std::make_unique<SourceInfo>();
+    info->tiles = { "{z}/{x}/{y}" };
+
+    Source source(SourceType::Vector, "source", "", 512, std::move(info), nullptr);
+    source.setObserver(&test.observer);
+    source.load(test.fileSource);
+    source.update(test.updateParameters);
+
+    EXPECT_EQ((std::set<TileID>{
+        TileID(2, 0, 1, 2), TileID(2, 1, 1, 2), TileID(2, 2, 1, 2), TileID(2, 3, 1, 2),
+        TileID(2, 0, 2, 2), TileID(2, 1, 2, 2), TileID(2, 2, 2, 2), TileID(2, 3, 2, 2),
+    }), tilesAtZoom(source, 2));
+
+    // The center, zoom, angle and size stay the same; only the north orientation changes.
+    test.transform.setNorthOrientation(NorthOrientation::Rightwards);
+    test.transformState = test.transform.getState();
+    test.updateParameters.animationTime += Seconds(1);
+    source.update(test.updateParameters);
+
+    EXPECT_EQ((std::set<TileID>{
+        TileID(2, 1, 0, 2), TileID(2, 1, 1, 2), TileID(2, 1, 2, 2), TileID(2, 1, 3, 2),
+        TileID(2, 2, 0, 2), TileID(2, 2, 1, 2), TileID(2, 2, 2, 2), TileID(2, 2, 3, 2),
+    }), tilesAtZoom(source, 2));
+}
+
+TEST(Source, PinnedParentTiles) {
+    SourceTest test;
+    test.mapData.setPrefetchParentTiles(true);
+
+    // Only the pinned parents two and four levels up respond; the tiles in view never load.
+    test.fileSource.tileResponse = [&] (const Resource& resource) {
+        if (resource.url.compare(0, 2, "4/") == 0) {
+            return optional<Response>();
+        }
+        Response response;
+        response.noContent = true;
+        return optional<Response>(response);
+    };
+
+    std::set<TileID> loaded;
+    test.observer.tileLoaded = [&] (Source&, const TileID& tileID, bool) {
+        loaded.insert(tileID);
+        if (loaded.size() == 5) {
+            test.end();
+        }
+    };
+
+    test.transform.setLatLngZoom({ 0, 0 }, 4);
+    test.transformState = test.transform.getState();
+
+    auto info = std::make_unique<SourceInfo>();
+    info->tiles = { "{z}/{x}/{y}" };
+
+    Source source(SourceType::Vector, "source", "", 512, std::move(info), nullptr);
+    source.setObserver(&test.observer);
+    source.load(test.fileSource);
+    source.update(test.updateParameters);
+
+    // Pinned parents are loaded, but not drawn while the tiles in view might still arrive.
+    test.run();
+    EXPECT_EQ((std::set<TileID>{
+        TileID(0, 0, 0, 0),
+        TileID(2, 1, 1, 2), TileID(2, 2, 1, 2), TileID(2, 1, 2, 2), TileID(2, 2, 2, 2),
+    }), loaded);
+    EXPECT_TRUE(tilesAtZoom(source, 2).empty());
+
+    // Once loaded, the closest pinned parents stand in for the missing tiles.
+    test.updateParameters.animationTime += Seconds(1);
+    source.update(test.updateParameters);
+    EXPECT_EQ((std::set<TileID>{
+        TileID(2, 1, 1, 2), TileID(2, 2, 1, 2), TileID(2, 1, 2, 2), TileID(2, 2, 2, 2),
+    }), tilesAtZoom(source, 2));
+    EXPECT_TRUE(tilesAtZoom(source, 0).empty());
+
+    // Parents that are no longer pinned, and that aren't drawn either, move to the TileCache.
+    test.mapData.setPrefetchParentTiles(false);
+    test.updateParameters.animationTime += Seconds(1);
+    source.update(test.updateParameters);
+    EXPECT_TRUE(test.tileCache.has("source", TileID(0, 0, 0, 0).to_uint64()));
+    EXPECT_FALSE(test.tileCache.has("source", TileID(2, 1, 1, 2).to_uint64()));
+    EXPECT_EQ(4u, tilesAtZoom(source, 2).size());
+}
@@ -4,6 +4,8 @@
 #include <mbgl/map/map_data.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_context.hpp>
 
 using namespace mbgl;
 
@@ -12,7 +14,7 @@ TEST(Style, UnusedSource) {
     util::ThreadContext context { "Map", util::ThreadType::Map, util::ThreadPriority::Regular };
     util::ThreadContext::Set(&context);
 
-    MapData data { MapMode::Still, GLContextMode::Unique, 1.0 };
+    MapData data { MapMode::Still, GLContextMode::Unique, 1.0, std::make_shared<WorkerPool>(1) };
     StubFileSource fileSource;
     Style style { data, fileSource };
 
@@ -34,7 +36,7 @@ TEST(Style, UnusedSourceActiveViaClassUpdate) {
     util::ThreadContext context { "Map", util::ThreadType::Map, util::ThreadPriority::Regular };
     util::ThreadContext::Set(&context);
 
-    MapData data { MapMode::Still, GLContextMode::Unique, 1.0 };
+    MapData data { MapMode::Still, GLContextMode::Unique, 1.0, std::make_shared<WorkerPool>(1) };
     StubFileSource fileSource;
     Style style { data, fileSource };
 
@@ -48,3 +50,38 @@ TEST(Style, UnusedSourceActiveViaClassUpdate) {
     EXPECT_TRUE(unusedSource);
     EXPECT_TRUE(unusedSource->isLoaded());
 }
+
+TEST(Style, PaintOnlyChange) {
+    util::RunLoop loop;
+    util::ThreadContext context { "Map", util::ThreadType::Map, util::ThreadPriority::Regular };
+    util::ThreadContext::Set(&context);
+
+    MapData data { MapMode::Still, GLContextMode::Unique, 1.0, std::make_shared<WorkerPool>(1) };
+    StubFileSource fileSource;
+    Style style { data, fileSource };
+
+    auto makeStyle = [] (const std::string& layout, const std::string& paint) {
+        return R"({ "version": 8, "sources": { "vector": { "type": "vector", "tiles": [ "http://example.com/{z}-{x}-{y}.vector.pbf" ] } }, )"
+               R"("layers": [ { "id": "line", "type": "line", "source": "vector", "source-layer": "roads", )"
+               R"("layout": )" + layout + R"(, "paint": )" + paint + R"( } ] })";
+    };
+
+    const std::string json = makeStyle(R"({ "line-cap": "round" })", R"({ "line-color": "red" })");
+    style.setJSON(json, "");
+
+    Source* source = style.getSource("vector");
+    StyleLayer* layer = style.getLayer("line");
+    ASSERT_TRUE(source);
+    ASSERT_TRUE(layer);
+
+    // Changing only the paint properties replaces the layers, but keeps the sources.
+    const std::string paintJSON = makeStyle(R"({ "line-cap": "round" })", R"({ "line-color": "blue" })");
+    EXPECT_TRUE(style.setPaintJSON(paintJSON, json));
+    EXPECT_EQ(source, style.getSource("vector"));
+    EXPECT_NE(layer, style.getLayer("line"));
+    ASSERT_TRUE(style.getLayer("line"));
+
+    // Layout changes require a reload.
+    const std::string layoutJSON = makeStyle(R"({ "line-cap": "butt" })", R"({ "line-color": "blue" })");
+    EXPECT_FALSE(style.setPaintJSON(layoutJSON, paintJSON));
+}
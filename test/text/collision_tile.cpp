@@ -0,0 +1,65 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+CollisionFeature makeFeature(float x, float y) {
+    return CollisionFeature({}, Anchor(x, y, 0, 0), -10, 10, -100, 100, 1, 0, false, false);
+}
+
+} // namespace
+
+TEST(CollisionTile, BorderBoxes) {
+    CollisionTile tile(PlacementConfig{});
+
+    auto inner = makeFeature(util::EXTENT / 2, util::EXTENT / 2);
+    tile.insertFeature(inner, tile.placeFeature(inner, false, false));
+    EXPECT_TRUE(tile.getBorderBoxes().empty());
+
+    auto edge = makeFeature(util::EXTENT - 50, util::EXTENT / 2);
+    tile.insertFeature(edge, tile.placeFeature(edge, false, false));
+    ASSERT_EQ(1u, tile.getBorderBoxes().size());
+    EXPECT_EQ(util::EXTENT - 50, tile.getBorderBoxes()[0].anchor.x);
+}
+
+TEST(CollisionTile, NeighbourBoxes) {
+    // A label along the right edge of the tile to the left...
+    CollisionTile left(PlacementConfig{});
+    auto feature = makeFeature(util::EXTENT - 50, util::EXTENT / 2);
+    left.insertFeature(feature, left.placeFeature(feature, false, false));
+
+    NeighbourBoxes neighbours;
+    neighbours[0] = std::make_shared<const BorderBoxes>(left.getBorderBoxes());
+
+    // ...collides with a label along the left edge of this tile, ...
+    CollisionTile tile(PlacementConfig{});
+    tile.insertNeighbourBoxes(neighbours);
+    EXPECT_GT(tile.placeFeature(makeFeature(50, util::EXTENT / 2), false, false), tile.minScale);
+
+    // ...but not with labels further away.
+    EXPECT_EQ(tile.minScale, tile.placeFeature(makeFeature(1000, util::EXTENT / 2), false, false));
+}
+
+TEST(CollisionTile, DiagonalNeighbourBoxes) {
+    // A label in the bottom right corner of the tile to the top left...
+    CollisionTile topLeft(PlacementConfig{});
+    auto feature = makeFeature(util::EXTENT - 5, util::EXTENT - 5);
+    topLeft.insertFeature(feature, topLeft.placeFeature(feature, false, false));
+
+    NeighbourBoxes neighbours;
+    neighbours[4] = std::make_shared<const BorderBoxes>(topLeft.getBorderBoxes());
+
+    // ...collides with a label in the top left corner of this tile, which shares no edge with
+    // that tile, ...
+    CollisionTile tile(PlacementConfig{});
+    tile.insertNeighbourBoxes(neighbours);
+    EXPECT_GT(tile.placeFeature(makeFeature(5, 5), false, false), tile.minScale);
+
+    // ...but not with labels in the other corners.
+    EXPECT_EQ(tile.minScale, tile.placeFeature(makeFeature(util::EXTENT - 5, 5), false, false));
+    EXPECT_EQ(tile.minScale, tile.placeFeature(makeFeature(5, util::EXTENT - 5), false, false));
+}
@@ -0,0 +1,34 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/text/placement_config.hpp>
+
+using namespace mbgl;
+
+TEST(PlacementConfig, Equivalent) {
+    const PlacementConfig config(0.5, 0.2, false, true);
+
+    EXPECT_TRUE(config.isEquivalent(config));
+    EXPECT_TRUE(config.isEquivalent({ 0.51, 0.2, false }));
+    EXPECT_TRUE(config.isEquivalent({ 0.5, 0.21, false }));
+    EXPECT_FALSE(config.isEquivalent({ 0.6, 0.2, false }));
+    EXPECT_FALSE(config.isEquivalent({ 0.5, 0.3, false }));
+
+    // Toggling collision debugging always needs a new placement.
+    EXPECT_FALSE(config.isEquivalent({ 0.5, 0.2, true }));
+}
+
+TEST(PlacementConfig, EquivalentOnlyWhileMoving) {
+    // Once the camera settles, labels placed for a nearby angle or pitch are placed again.
+    const PlacementConfig settled(0.5, 0.2, false, false);
+
+    EXPECT_TRUE(settled.isEquivalent({ 0.5, 0.2, false, true }));
+    EXPECT_FALSE(settled.isEquivalent({ 0.51, 0.2, false, true }));
+    EXPECT_FALSE(settled.isEquivalent({ 0.5, 0.21, false, true }));
+}
+
+TEST(PlacementConfig, EquivalentAcrossWrap) {
+    const PlacementConfig config(M_PI - 0.01, 0, false, true);
+
+    EXPECT_TRUE(config.isEquivalent({ -M_PI + 0.01, 0, false }));
+    EXPECT_FALSE(config.isEquivalent({ -M_PI + 0.1, 0, false }));
+}
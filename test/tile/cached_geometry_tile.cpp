@@ -0,0 +1,148 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/tile/cached_geometry_tile.hpp>
+#include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Counts how often its features are asked for property values.
+class CountingFeature : public GeometryTileFeature {
+public:
+    CountingFeature(std::size_t& valueLookups_, std::string value_)
+        : valueLookups(valueLookups_), value(std::move(value_)) {}
+
+    FeatureType getType() const override { return FeatureType::Point; }
+    optional<Value> getValue(const std::string& key) const override {
+        valueLookups++;
+        return key == "class" ? optional<Value>(value) : optional<Value>();
+    }
+    GeometryCollection getGeometries() const override { return {{ { 1, 2 } }}; }
+    uint32_t getExtent() const override { return 4096; }
+
+private:
+    std::size_t& valueLookups;
+    const std::string value;
+};
+
+// Streams its geometry, and counts how often it is materialized or streamed.
+class StreamingFeature : public GeometryTileFeature {
+public:
+    StreamingFeature(std::size_t& materialized_, std::size_t& streamed_)
+        : materialized(materialized_), streamed(streamed_) {}
+
+    FeatureType getType() const override { return FeatureType::LineString; }
+    optional<Value> getValue(const std::string&) const override { return {}; }
+    GeometryCollection getGeometries() const override {
+        materialized++;
+        return {{ { 1, 2 }, { 3, 4 } }, {{ 5, 6 }, { 7, 8 }}};
+    }
+    void visitGeometries(GeometryVisitor& visitor) const override {
+        streamed++;
+        visitGeometryCollection({{ { 1, 2 }, { 3, 4 } }, {{ 5, 6 }, { 7, 8 }}}, visitor);
+    }
+    uint32_t getExtent() const override { return 4096; }
+
+private:
+    std::size_t& materialized;
+    std::size_t& streamed;
+};
+
+class CountingLayer : public GeometryTileLayer {
+public:
+    std::size_t featureCount() const override { return features.size(); }
+    util::ptr<const GeometryTileFeature> getFeature(std::size_t i) const override { return features[i]; }
+
+    std::vector<util::ptr<const GeometryTileFeature>> features;
+};
+
+class CountingTile : public GeometryTile {
+public:
+    util::ptr<GeometryTileLayer> getLayer(const std::string&) const override { return layer; }
+
+    util::ptr<CountingLayer> layer = std::make_shared<CountingLayer>();
+};
+
+} // namespace
+
+TEST(CachedGeometryTile, SharesLayersAndFeatures) {
+    VectorTile tile(std::make_shared<const std::string>(util::read_file("test/fixtures/resources/vector.pbf")));
+    CachedGeometryTile cachedTile(tile);
+
+    EXPECT_EQ(nullptr, cachedTile.getLayer("does-not-exist"));
+
+    auto layer = cachedTile.getLayer("road");
+    ASSERT_NE(nullptr, layer);
+    EXPECT_EQ(layer, cachedTile.getLayer("road"));
+    EXPECT_EQ(layer->getFeature(0)->getGeometries(), layer->getFeature(0)->getGeometries());
+
+    auto original = tile.getLayer("road");
+    ASSERT_EQ(original->featureCount(), layer->featureCount());
+
+    std::size_t i = 0;
+    layer->eachFeature([&] (const GeometryTileFeature& feature) {
+        auto expected = original->getFeature(i++);
+        EXPECT_EQ(expected->getType(), feature.getType());
+        EXPECT_EQ(expected->getExtent(), feature.getExtent());
+        EXPECT_EQ(expected->getValue("class"), feature.getValue("class"));
+        EXPECT_EQ(expected->getValue("class"), feature.getValue("class"));
+        EXPECT_EQ(expected->getValue("does-not-exist"), feature.getValue("does-not-exist"));
+        EXPECT_EQ(expected->getGeometries(), feature.getGeometries());
+    });
+    EXPECT_EQ(original->featureCount(), i);
+}
+
+TEST(CachedGeometryTile, DecodesValuesOncePerKey) {
+    std::size_t valueLookups = 0;
+    CountingTile tile;
+    tile.layer->features.push_back(std::make_shared<CountingFeature>(valueLookups, "motorway"));
+    tile.layer->features.push_back(std::make_shared<CountingFeature>(valueLookups, "path"));
+
+    CachedGeometryTile cachedTile(tile);
+    auto layer = cachedTile.getLayer("road");
+
+    // Keys are resolved to columns of the cached layer, which style layers share.
+    const optional<uint32_t> key = layer->getKeyIndex("class");
+    ASSERT_TRUE(bool(key));
+    EXPECT_EQ(key, layer->getKeyIndex("class"));
+    EXPECT_EQ(0u, valueLookups);
+
+    for (int pass = 0; pass < 3; pass++) {
+        std::vector<optional<Value>> values;
+        layer->eachFeature([&] (const GeometryTileFeature& feature) {
+            values.push_back(feature.getIndexedValue(*key));
+            EXPECT_EQ(values.back(), feature.getValue("class"));
+        });
+        EXPECT_EQ((std::vector<optional<Value>>{ Value(std::string("motorway")), Value(std::string("path")) }), values);
+    }
+    EXPECT_EQ(2u, valueLookups);
+
+    layer->getFeature(1)->getValue("name");
+    EXPECT_EQ(4u, valueLookups);
+}
+
+TEST(CachedGeometryTile, StreamsGeometries) {
+    std::size_t materialized = 0;
+    std::size_t streamed = 0;
+    CountingTile tile;
+    tile.layer->features.push_back(std::make_shared<StreamingFeature>(materialized, streamed));
+    tile.layer->features.push_back(std::make_shared<StreamingFeature>(materialized, streamed));
+
+    CachedGeometryTile cachedTile(tile);
+    auto layer = cachedTile.getLayer("road");
+
+    // The source features stream their geometry into the cache once. Buckets visiting the
+    // cached features receive it without a GeometryCollection in between.
+    for (int pass = 0; pass < 3; pass++) {
+        layer->eachFeature([&] (const GeometryTileFeature& feature) {
+            GeometryCollection geometries;
+            GeometryCollectionBuilder builder(geometries);
+            feature.visitGeometries(builder);
+            EXPECT_EQ((GeometryCollection{{ { 1, 2 }, { 3, 4 } }, {{ 5, 6 }, { 7, 8 }}}), geometries);
+        });
+    }
+    EXPECT_EQ(0u, materialized);
+    EXPECT_EQ(2u, streamed);
+}
@@ -0,0 +1,96 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/tile/tile_cache.hpp>
+#include <mbgl/tile/tile_data.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+class FakeTileData : public TileData {
+public:
+    FakeTileData(const TileID& id_, std::size_t size_)
+        : TileData(id_), size(size_) {
+        state = State::parsed;
+    }
+
+    void cancel() override {}
+    Bucket* getBucket(const StyleLayer&) override { return nullptr; }
+    std::size_t getByteSize() const override { return size; }
+
+private:
+    const std::size_t size;
+};
+
+std::shared_ptr<TileData> makeTile(std::size_t size) {
+    return std::make_shared<FakeTileData>(TileID(0, 0, 0, 0), size);
+}
+
+} // namespace
+
+TEST(TileCache, EvictsLeastRecentlyAddedBeyondBudget) {
+    TileCache cache(300 * 1024);
+
+    cache.add("a", 1, makeTile(100 * 1024));
+    cache.add("a", 2, makeTile(100 * 1024));
+    cache.add("b", 1, makeTile(100 * 1024));
+    EXPECT_EQ(300u * 1024, cache.getUsedSize());
+
+    // Re-adding a tile makes it the newest one.
+    cache.add("a", 1, makeTile(100 * 1024));
+    cache.add("b", 2, makeTile(100 * 1024));
+
+    EXPECT_TRUE(cache.has("a", 1));
+    EXPECT_FALSE(cache.has("a", 2));
+    EXPECT_TRUE(cache.has("b", 1));
+    EXPECT_TRUE(cache.has("b", 2));
+    EXPECT_EQ(300u * 1024, cache.getUsedSize());
+
+    // Shrinking the budget evicts the oldest tiles first.
+    cache.setSize(150 * 1024);
+    EXPECT_FALSE(cache.has("b", 1));
+    EXPECT_FALSE(cache.has("a", 1));
+    EXPECT_TRUE(cache.has("b", 2));
+    EXPECT_EQ(100u * 1024, cache.getUsedSize());
+}
+
+TEST(TileCache, GetRemovesTile) {
+    TileCache cache(1024 * 1024);
+
+    auto tile = makeTile(200 * 1024);
+    cache.add("a", 1, tile);
+    EXPECT_EQ(nullptr, cache.get("b", 1));
+    EXPECT_EQ(tile, cache.get("a", 1));
+    EXPECT_FALSE(cache.has("a", 1));
+    EXPECT_EQ(0u, cache.getUsedSize());
+}
+
+TEST(TileCache, ClearsOneSource) {
+    TileCache cache(1024 * 1024);
+
+    cache.add("a", 1, makeTile(10 * 1024));
+    cache.add("b", 1, makeTile(10 * 1024));
+    cache.add("a", 2, makeTile(10 * 1024));
+
+    cache.clear("a");
+    EXPECT_FALSE(cache.has("a", 1));
+    EXPECT_FALSE(cache.has("a", 2));
+    EXPECT_TRUE(cache.has("b", 1));
+    EXPECT_EQ(10u * 1024, cache.getUsedSize());
+
+    cache.clear();
+    EXPECT_FALSE(cache.has("b", 1));
+    EXPECT_EQ(0u, cache.getUsedSize());
+}
+
+TEST(TileCache, EmptyTilesCountTowardsBudget) {
+    TileCache cache(64 * 1024);
+
+    for (uint64_t i = 0; i < 100; i++) {
+        cache.add("a", i, makeTile(0));
+    }
+
+    EXPECT_LE(cache.getUsedSize(), 64u * 1024);
+    EXPECT_FALSE(cache.has("a", 0));
+    EXPECT_TRUE(cache.has("a", 99));
+}
@@ -0,0 +1,247 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/map/shared_tile_cache.hpp>
+#include <mbgl/storage/file_source.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <thread>
+
+using namespace mbgl;
+
+namespace {
+
+std::shared_ptr<const std::string> readTile() {
+    return std::make_shared<const std::string>(util::read_file("test/fixtures/resources/vector.pbf"));
+}
+
+} // namespace
+
+TEST(VectorTile, MissingLayer) {
+    VectorTile tile(readTile());
+    EXPECT_EQ(nullptr, tile.getLayer("does-not-exist"));
+}
+
+TEST(VectorTile, FeatureCount) {
+    VectorTile tile(readTile());
+    EXPECT_EQ(267u, tile.getLayer("road")->featureCount());
+    EXPECT_EQ(105u, tile.getLayer("housenum_label")->featureCount());
+    EXPECT_EQ(0u, tile.getLayer("water")->featureCount());
+}
+
+TEST(VectorTile, EachFeatureMatchesGetFeature) {
+    VectorTile tile(readTile());
+    auto layer = tile.getLayer("poi_label");
+    ASSERT_NE(nullptr, layer);
+
+    std::size_t i = 0;
+    layer->eachFeature([&] (const GeometryTileFeature& feature) {
+        auto expected = layer->getFeature(i++);
+        EXPECT_EQ(expected->getType(), feature.getType());
+        EXPECT_EQ(expected->getValue("name"), feature.getValue("name"));
+        EXPECT_EQ(expected->getGeometries(), feature.getGeometries());
+    });
+    EXPECT_EQ(layer->featureCount(), i);
+
+    EXPECT_THROW(layer->getFeature(layer->featureCount()), std::out_of_range);
+}
+
+TEST(VectorTile, EachFeatureStops) {
+    VectorTile tile(readTile());
+    auto layer = tile.getLayer("road");
+    ASSERT_NE(nullptr, layer);
+
+    std::size_t visited = 0;
+    auto count = [&] (const GeometryTileFeature&) { visited++; };
+
+    EXPECT_EQ(layer->featureCount(), layer->eachFeature(count));
+    EXPECT_EQ(layer->featureCount(), visited);
+
+    // The remaining features are neither visited nor turned into views once stop returns true.
+    visited = 0;
+    EXPECT_EQ(3u, layer->eachFeature(count, [&] { return visited == 3; }));
+    EXPECT_EQ(3u, visited);
+
+    visited = 0;
+    EXPECT_EQ(0u, layer->eachFeature(count, [] { return true; }));
+    EXPECT_EQ(0u, visited);
+}
+
+TEST(VectorTile, FeatureProperties) {
+    VectorTile tile(readTile());
+    auto feature = tile.getLayer("road")->getFeature(0);
+
+    EXPECT_EQ(FeatureType::LineString, feature->getType());
+    EXPECT_EQ(4096u, feature->getExtent());
+    EXPECT_TRUE(bool(feature->getValue("class")));
+    EXPECT_FALSE(bool(feature->getValue("does-not-exist")));
+    EXPECT_FALSE(feature->getGeometries().empty());
+}
+
+TEST(VectorTile, KeyIndex) {
+    VectorTile tile(readTile());
+    auto layer = tile.getLayer("road");
+
+    auto classKey = layer->getKeyIndex("class");
+    auto missingKey = layer->getKeyIndex("does-not-exist");
+    ASSERT_TRUE(bool(classKey));
+    ASSERT_TRUE(bool(missingKey));
+
+    const std::string name = "class";
+    GeometryTileLayerKeys keys(*layer);
+    keys.add(name);
+
+    layer->eachFeature([&] (const GeometryTileFeature& feature) {
+        EXPECT_EQ(feature.getValue("class"), feature.getIndexedValue(*classKey));
+        EXPECT_EQ(feature.getValue("class"), keys.getValue(feature, name));
+        EXPECT_EQ(feature.getValue("class"), keys.getValue(feature, "class"));
+        EXPECT_EQ(feature.getValue("osm_id"), keys.getValue(feature, "osm_id"));
+        EXPECT_FALSE(bool(feature.getIndexedValue(*missingKey)));
+    });
+}
+
+TEST(VectorTile, VisitGeometries) {
+    VectorTile tile(readTile());
+
+    tile.getLayer("building")->eachFeature([&] (const GeometryTileFeature& feature) {
+        GeometryCollection rings;
+        GeometryCollectionBuilder builder(rings);
+        feature.visitGeometries(builder);
+
+        ASSERT_FALSE(rings.empty());
+        EXPECT_EQ(feature.getGeometries(), rings);
+        for (const auto& ring : rings) {
+            // closePolygon repeats the first point of the ring.
+            EXPECT_LE(4u, ring.size());
+            EXPECT_EQ(ring.front(), ring.back());
+        }
+    });
+
+    tile.getLayer("poi_label")->eachFeature([&] (const GeometryTileFeature& feature) {
+        GeometryCollection points;
+        GeometryCollectionBuilder builder(points);
+        feature.visitGeometries(builder);
+
+        ASSERT_EQ(1u, points.size());
+        EXPECT_EQ(1u, points[0].size());
+    });
+}
+
+TEST(VectorTile, LayersAreDecodedOnce) {
+    VectorTile tile(readTile());
+    auto layer = tile.getLayer("housenum_label");
+    ASSERT_NE(nullptr, layer);
+    EXPECT_EQ(layer, tile.getLayer("housenum_label"));
+    EXPECT_NE(layer, tile.getLayer("road"));
+}
+
+namespace {
+
+// A tile with a single point feature in layer "test", whose properties "a" and "b" have the values
+// "x" and an int_value varint that is cut short.
+std::shared_ptr<const std::string> lazyValueTile() {
+    const std::string layer {
+        0x0A, 0x04, 't', 'e', 's', 't',             // name
+        0x1A, 0x01, 'a',                            // keys
+        0x1A, 0x01, 'b',
+        0x22, 0x03, 0x0A, 0x01, 'x',                // values
+        0x22, 0x02, 0x20, char(0x80),
+        0x12, 0x0D,                                 // feature
+            0x12, 0x04, 0x00, 0x00, 0x01, 0x01,     // tags
+            0x18, 0x01,                             // type
+            0x22, 0x03, 0x09, 0x02, 0x02,           // geometry
+        0x28, char(0x80), 0x20,                     // extent
+    };
+    return std::make_shared<const std::string>(std::string { 0x1A, char(layer.size()) } + layer);
+}
+
+} // namespace
+
+TEST(VectorTile, ValuesAreDecodedLazily) {
+    VectorTile tile(lazyValueTile());
+    auto layer = tile.getLayer("test");
+    ASSERT_NE(nullptr, layer);
+    ASSERT_EQ(1u, layer->featureCount());
+
+    // The malformed value is only decoded when it is requested.
+    auto feature = layer->getFeature(0);
+    EXPECT_EQ(FeatureType::Point, feature->getType());
+    EXPECT_EQ(optional<Value>(std::string("x")), feature->getValue("a"));
+    EXPECT_EQ(optional<Value>(std::string("x")), feature->getValue("a"));
+    EXPECT_THROW(feature->getValue("b"), std::exception);
+}
+
+TEST(VectorTile, ValuesAreDecodedOnceAcrossThreads) {
+    VectorTile tile(readTile());
+    auto layer = tile.getLayer("poi_label");
+    ASSERT_NE(nullptr, layer);
+
+    std::vector<optional<Value>> expected;
+    VectorTile(readTile()).getLayer("poi_label")->eachFeature([&] (const GeometryTileFeature& feature) {
+        expected.push_back(feature.getValue("name"));
+    });
+
+    std::vector<std::thread> threads;
+    std::vector<std::vector<optional<Value>>> results(4);
+    for (auto& result : results) {
+        threads.emplace_back([&] {
+            layer->eachFeature([&] (const GeometryTileFeature& feature) {
+                result.push_back(feature.getValue("name"));
+            });
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& result : results) {
+        EXPECT_EQ(expected, result);
+    }
+}
+
+namespace {
+
+// Responds to every request right away, with a separate copy of the same tile.
+class TileFileSource : public FileSource {
+public:
+    std::unique_ptr<FileRequest> request(const Resource&, Callback callback) override {
+        Response response;
+        response.data = readTile();
+        callback(response);
+        return std::make_unique<FileRequest>();
+    }
+};
+
+} // namespace
+
+TEST(VectorTile, SharedTileCache) {
+    TileFileSource fileSource;
+    auto cache = std::make_shared<SharedTileCache>();
+
+    std::vector<std::unique_ptr<GeometryTile>> tiles;
+    auto callback = [&] (std::exception_ptr error, std::unique_ptr<GeometryTile> tile,
+                         optional<SystemTimePoint>, optional<SystemTimePoint>) {
+        EXPECT_EQ(nullptr, error);
+        tiles.push_back(std::move(tile));
+    };
+
+    VectorTileMonitor first(TileID(0, 0, 0, 0), 1.0, "http://example.com/{z}/{x}/{y}.pbf", fileSource, cache.get());
+    VectorTileMonitor second(TileID(0, 0, 0, 0), 1.0, "http://example.com/{z}/{x}/{y}.pbf", fileSource, cache.get());
+    auto other = std::make_unique<VectorTileMonitor>(TileID(1, 0, 0, 1), 1.0, "http://example.com/{z}/{x}/{y}.pbf", fileSource, cache.get());
+    auto firstRequest = first.monitorTile(callback);
+    auto secondRequest = second.monitorTile(callback);
+    auto otherRequest = other->monitorTile(callback);
+
+    ASSERT_EQ(3u, tiles.size());
+    EXPECT_EQ(2u, cache->getTileCount());
+
+    // Both maps read the layers that were decoded once.
+    EXPECT_EQ(tiles[0]->getLayer("road"), tiles[1]->getLayer("road"));
+    EXPECT_NE(tiles[0]->getLayer("road"), tiles[2]->getLayer("road"));
+
+    // A tile leaves the cache once no monitor uses it anymore.
+    tiles.clear();
+    otherRequest.reset();
+    other.reset();
+    EXPECT_EQ(1u, cache->getTileCount());
+}
@@ -0,0 +1,99 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/earcut.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+std::size_t triangulate(const GeometryCollection& rings, bool& valid) {
+    util::Earcut earcut;
+    std::vector<uint32_t> indices;
+    valid = earcut(rings.begin(), rings.end(), indices);
+    EXPECT_EQ(0u, indices.size() % 3);
+    return indices.size() / 3;
+}
+
+} // namespace
+
+TEST(Earcut, Square) {
+    bool valid;
+    EXPECT_EQ(2u, triangulate({ { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 } } }, valid));
+    EXPECT_TRUE(valid);
+
+    // Winding order doesn't matter.
+    EXPECT_EQ(2u, triangulate({ { { 0, 0 }, { 0, 10 }, { 10, 10 }, { 10, 0 } } }, valid));
+    EXPECT_TRUE(valid);
+}
+
+TEST(Earcut, Concave) {
+    bool valid;
+    EXPECT_EQ(4u, triangulate({ { { 0, 0 }, { 20, 0 }, { 20, 20 }, { 10, 5 }, { 0, 20 }, { 5, 10 } } }, valid));
+    EXPECT_TRUE(valid);
+}
+
+TEST(Earcut, Hole) {
+    bool valid;
+    EXPECT_EQ(8u, triangulate({
+        { { 0, 0 }, { 30, 0 }, { 30, 30 }, { 0, 30 } },
+        { { 10, 10 }, { 10, 20 }, { 20, 20 }, { 20, 10 } },
+    }, valid));
+    EXPECT_TRUE(valid);
+}
+
+TEST(Earcut, LargePolygon) {
+    // Polygons with many vertices are indexed in z-order.
+    std::vector<Coordinate> circle;
+    for (int i = 0; i < 500; i++) {
+        const double angle = 2 * M_PI * i / 500;
+        circle.emplace_back(std::round(2048 + 2000 * std::cos(angle)),
+                            std::round(2048 + 2000 * std::sin(angle)));
+    }
+
+    bool valid;
+    EXPECT_EQ(498u, triangulate({ circle }, valid));
+    EXPECT_TRUE(valid);
+}
+
+TEST(Earcut, SelfIntersecting) {
+    bool valid;
+    triangulate({ { { 0, 0 }, { 10, 10 }, { 10, 0 }, { 0, 10 } } }, valid);
+    EXPECT_FALSE(valid);
+
+    // A hole that crosses the outer ring.
+    triangulate({
+        { { 0, 0 }, { 30, 0 }, { 30, 30 }, { 0, 30 } },
+        { { 10, 10 }, { 10, 40 }, { 20, 40 }, { 20, 10 } },
+    }, valid);
+    EXPECT_FALSE(valid);
+}
+
+TEST(Earcut, WindingMatchesNesting) {
+    const std::vector<Coordinate> outer { { 0, 0 }, { 30, 0 }, { 30, 30 }, { 0, 30 } };
+    const std::vector<Coordinate> hole { { 10, 10 }, { 10, 20 }, { 20, 20 }, { 20, 10 } };
+    const std::vector<Coordinate> sameWoundHole { { 10, 10 }, { 20, 10 }, { 20, 20 }, { 10, 20 } };
+    const std::vector<Coordinate> island { { 40, 0 }, { 50, 0 }, { 50, 10 }, { 40, 10 } };
+    const std::vector<Coordinate> reversedIsland { { 40, 0 }, { 40, 10 }, { 50, 10 }, { 50, 0 } };
+    const std::vector<Coordinate> wideHole { { 5, 5 }, { 5, 25 }, { 25, 25 }, { 25, 5 } };
+    const std::vector<Coordinate> islandInHole { { 10, 10 }, { 20, 10 }, { 20, 20 }, { 10, 20 } };
+
+    auto matches = [] (const GeometryCollection& rings) {
+        return util::windingMatchesNesting(rings.begin(), rings.end());
+    };
+
+    EXPECT_TRUE(matches({ outer }));
+    EXPECT_TRUE(matches({ outer, hole }));
+    EXPECT_TRUE(matches({ outer, hole, island }));
+
+    // An island inside a hole is a separate polygon, even though it lies within the outer ring.
+    EXPECT_TRUE(matches({ outer, wideHole, islandInHole }));
+    EXPECT_TRUE(matches({ outer, wideHole, islandInHole, island }));
+
+    // A hole wound like its outer ring would be filled if rings were told apart by winding alone.
+    EXPECT_FALSE(matches({ outer, sameWoundHole }));
+
+    // A separate polygon wound like a hole would be dropped.
+    EXPECT_FALSE(matches({ outer, reversedIsland }));
+}
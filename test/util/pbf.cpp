@@ -0,0 +1,84 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/pbf.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+void encode(std::string& buffer, uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(char(value));
+}
+
+pbf reader(const std::string& buffer) {
+    return pbf(reinterpret_cast<const unsigned char *>(buffer.data()), buffer.size());
+}
+
+} // namespace
+
+TEST(PBF, Varint) {
+    const std::vector<uint64_t> values = {
+        0, 1, 127, 128, 300, 16383, 16384, 2097151, 2097152, 268435455, 268435456,
+        0xFFFFFFFFULL, 0x00FFFFFFFFFFFFFFULL, 0x0100000000000000ULL, 0xFFFFFFFFFFFFFFFFULL
+    };
+
+    std::string buffer;
+    for (auto value : values) {
+        encode(buffer, value);
+    }
+
+    pbf data = reader(buffer);
+    for (auto value : values) {
+        EXPECT_EQ(value, data.varint<uint64_t>());
+    }
+    EXPECT_FALSE(data);
+}
+
+TEST(PBF, Svarint) {
+    std::string buffer;
+    encode(buffer, 0);
+    encode(buffer, 1);
+    encode(buffer, 2);
+    encode(buffer, 4294967295);
+
+    pbf data = reader(buffer);
+    EXPECT_EQ(0, int32_t(data.svarint()));
+    EXPECT_EQ(-1, int32_t(data.svarint()));
+    EXPECT_EQ(1, int32_t(data.svarint()));
+    EXPECT_EQ(INT32_MIN, int32_t(data.svarint()));
+}
+
+TEST(PBF, PackedVarints) {
+    std::mt19937 generator(42);
+    std::vector<uint32_t> values;
+    std::string buffer;
+    for (int i = 0; i < 1000; i++) {
+        // Exercise all encoded lengths between one and five bytes.
+        const uint32_t value = generator() >> (generator() % 32);
+        values.push_back(value);
+        encode(buffer, value);
+    }
+
+    std::vector<uint32_t> decoded;
+    reader(buffer).varints(decoded);
+    EXPECT_EQ(values, decoded);
+}
+
+TEST(PBF, UnterminatedVarint) {
+    std::string buffer;
+    encode(buffer, 300);
+    buffer.push_back(char(0x80));
+
+    std::vector<uint32_t> decoded;
+    EXPECT_THROW(reader(buffer).varints(decoded), pbf::unterminated_varint_exception);
+
+    const std::string tooLong(12, char(0xFF));
+    pbf data = reader(tooLong);
+    EXPECT_THROW(data.varint<uint64_t>(), pbf::varint_too_long_exception);
+}
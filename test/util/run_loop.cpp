@@ -3,6 +3,9 @@
 
 #include "../fixtures/util.hpp"
 
+#include <thread>
+#include <vector>
+
 using namespace mbgl::util;
 
 TEST(RunLoop, Stop) {
@@ -29,3 +32,36 @@ TEST(RunLoop, MultipleStop) {
 
     loop.run();
 }
+
+TEST(RunLoop, InvokeFromOtherThreads) {
+    RunLoop loop(RunLoop::Type::New);
+
+    const int threads = 4;
+    const int tasks = 1000;
+    std::vector<int> last(threads, -1);
+    int count = 0;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; t++) {
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < tasks; i++) {
+                loop.invoke([&, t, i] {
+                    // Tasks from one thread run in the order in which they were pushed.
+                    EXPECT_EQ(last[t] + 1, i);
+                    last[t] = i;
+                    if (++count == threads * tasks) {
+                        loop.stop();
+                    }
+                });
+            }
+        });
+    }
+
+    loop.run();
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(threads * tasks, count);
+}
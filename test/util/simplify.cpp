@@ -0,0 +1,69 @@
+#include "../fixtures/util.hpp"
+
+#include <mbgl/util/simplify.hpp>
+
+using namespace mbgl;
+
+using Points = std::vector<Coordinate>;
+
+TEST(Simplify, Tolerance) {
+    EXPECT_FALSE(util::Simplifier());
+    EXPECT_TRUE(util::Simplifier(1));
+
+    // A pixel is 16 tile units at 512 pixels per tile, and half of that at twice the size.
+    EXPECT_DOUBLE_EQ(8, util::Simplifier::tolerance(1, 1));
+    EXPECT_DOUBLE_EQ(2, util::Simplifier::tolerance(1, 4));
+}
+
+TEST(Simplify, Line) {
+    util::Simplifier simplifier(2);
+    Points output;
+
+    // Vertices close to the line are removed, the end points are kept.
+    simplifier.simplifyLine({ { 0, 0 }, { 10, 1 }, { 20, -1 }, { 30, 0 } }, output);
+    EXPECT_EQ((Points{ { 0, 0 }, { 30, 0 } }), output);
+
+    output.clear();
+    simplifier.simplifyLine({ { 0, 0 }, { 10, 4 }, { 20, 10 }, { 30, 0 } }, output);
+    EXPECT_EQ((Points{ { 0, 0 }, { 20, 10 }, { 30, 0 } }), output);
+
+    output.clear();
+    simplifier.simplifyLine({ { 0, 0 }, { 1, 1 } }, output);
+    EXPECT_EQ((Points{ { 0, 0 }, { 1, 1 } }), output);
+}
+
+TEST(Simplify, Ring) {
+    util::Simplifier simplifier(2);
+    Points output;
+
+    // Collinear vertices along the edges of a square are removed.
+    EXPECT_TRUE(simplifier.simplifyRing({ { 0, 0 }, { 50, 1 }, { 100, 0 }, { 100, 100 }, { 50, 99 }, { 0, 100 } }, output));
+    EXPECT_EQ((Points{ { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 } }), output);
+}
+
+TEST(Simplify, CollapsedRing) {
+    util::Simplifier simplifier(4);
+    Points output;
+
+    // Rings that are smaller than the tolerance are dropped.
+    EXPECT_FALSE(simplifier.simplifyRing({ { 0, 0 }, { 2, 0 }, { 3, 1 }, { 2, 2 }, { 0, 2 } }, output));
+    EXPECT_TRUE(output.empty());
+
+    // Thin rings that are larger than the tolerance are kept as they are.
+    const Points thin { { 0, 0 }, { 50, 1 }, { 100, 0 }, { 100, 2 }, { 50, 3 }, { 0, 2 } };
+    EXPECT_TRUE(simplifier.simplifyRing(thin, output));
+    EXPECT_EQ(thin, output);
+}
+
+TEST(Simplify, Stats) {
+    const auto before = util::Simplifier::getStats();
+    {
+        util::Simplifier simplifier(2);
+        Points output;
+        simplifier.simplifyLine({ { 0, 0 }, { 10, 1 }, { 20, -1 }, { 30, 0 } }, output);
+    }
+    const auto after = util::Simplifier::getStats();
+
+    EXPECT_EQ(4u, after.vertices - before.vertices);
+    EXPECT_EQ(2u, after.removedVertices - before.removedVertices);
+}
@@ -0,0 +1,202 @@
+#include <mbgl/util/thread_pool.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/worker_pool.hpp>
+
+#include "../fixtures/util.hpp"
+
+#include <future>
+#include <set>
+
+using namespace mbgl::util;
+
+TEST(ThreadPool, ExecutesAfter) {
+    const std::thread::id tid = std::this_thread::get_id();
+
+    RunLoop loop;
+    ThreadPool pool({"Test", ThreadType::Worker, ThreadPriority::Regular}, 4);
+
+    std::vector<std::unique_ptr<mbgl::WorkRequest>> requests;
+    std::set<std::thread::id> workers;
+    std::mutex mutex;
+    int remaining = 16;
+
+    for (int i = 0; i < 16; i++) {
+        requests.push_back(pool.invokeWithCallback([&] (int value, std::function<void (int)> cb) {
+            EXPECT_NE(tid, std::this_thread::get_id());
+            EXPECT_TRUE(ThreadContext::currentlyOn(ThreadType::Worker));
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                workers.insert(std::this_thread::get_id());
+            }
+            cb(value * 2);
+        }, [&, i] (int result) {
+            EXPECT_EQ(tid, std::this_thread::get_id());
+            EXPECT_EQ(result, i * 2);
+            if (--remaining == 0) {
+                loop.stop();
+            }
+        }, i));
+    }
+
+    loop.run();
+
+    EXPECT_EQ(remaining, 0);
+    EXPECT_LE(workers.size(), 4u);
+}
+
+TEST(ThreadPool, RunsQueuedTasksWhileOneThreadIsBlocked) {
+    RunLoop loop;
+    ThreadPool pool({"Test", ThreadType::Worker, ThreadPriority::Regular}, 2);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::vector<std::unique_ptr<mbgl::WorkRequest>> requests;
+
+    // The first task blocks its thread until every other task has finished, which can
+    // only happen if the other thread runs all of the tasks queued after it.
+    requests.push_back(pool.invokeWithCallback([released] (std::function<void ()> cb) {
+        released.wait();
+        cb();
+    }, [&] {
+        loop.stop();
+    }));
+
+    int remaining = 8;
+    for (int i = 0; i < 8; i++) {
+        requests.push_back(pool.invokeWithCallback([] (std::function<void ()> cb) {
+            cb();
+        }, [&] {
+            if (--remaining == 0) {
+                release.set_value();
+            }
+        }));
+    }
+
+    loop.run();
+
+    EXPECT_EQ(remaining, 0);
+}
+
+TEST(ThreadPool, RunsLowerPriorityValuesFirst) {
+    RunLoop loop;
+    ThreadPool pool({"Test", ThreadType::Worker, ThreadPriority::Regular}, 1);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::vector<std::unique_ptr<mbgl::WorkRequest>> requests;
+    std::vector<int> order;
+
+    // Occupy the only thread while the other tasks are queued and re-ranked.
+    requests.push_back(pool.invokeWithCallback([released] (std::function<void ()> cb) {
+        released.wait();
+        cb();
+    }, [] {}));
+
+    for (int i = 0; i < 4; i++) {
+        requests.push_back(pool.invokeWithCallback([i] (std::function<void (int)> cb) {
+            cb(i);
+        }, [&] (int result) {
+            order.push_back(result);
+            if (order.size() == 4) {
+                loop.stop();
+            }
+        }));
+        requests.back()->setPriority(10 - i);
+    }
+    requests[2]->setPriority(0);
+
+    release.set_value();
+    loop.run();
+
+    EXPECT_EQ((std::vector<int>{ 1, 3, 2, 0 }), order);
+}
+
+TEST(ThreadPool, RunsLowerPriorityValuesFirstAcrossThreads) {
+    RunLoop loop;
+    ThreadPool pool({"Test", ThreadType::Worker, ThreadPriority::Regular}, 2);
+
+    std::promise<void> release[2];
+    std::promise<void> started[2];
+    std::vector<std::unique_ptr<mbgl::WorkRequest>> requests;
+    std::vector<int> order;
+
+    // Occupy both threads, so that every task is queued before any of them can run.
+    for (int i = 0; i < 2; i++) {
+        std::shared_future<void> released = release[i].get_future().share();
+        requests.push_back(pool.invokeWithCallback([&started, released, i] (std::function<void ()> cb) {
+            started[i].set_value();
+            released.wait();
+            cb();
+        }, [] {}));
+    }
+    started[0].get_future().wait();
+    started[1].get_future().wait();
+
+    // Queued with their priority, so there is no window in which they compete at the default.
+    for (int i = 0; i < 6; i++) {
+        requests.push_back(pool.invokeWithPriority(10 - i, [i] (std::function<void (int)> cb) {
+            cb(i);
+        }, [&] (int result) {
+            order.push_back(result);
+            if (order.size() == 6) {
+                loop.stop();
+            }
+        }));
+    }
+
+    // A single free thread has to pick the best task of the whole pool every time.
+    release[0].set_value();
+    loop.run();
+    release[1].set_value();
+
+    EXPECT_EQ((std::vector<int>{ 5, 4, 3, 2, 1, 0 }), order);
+}
+
+TEST(ThreadPool, WorkRequestDeletionWaitsForWorkToComplete) {
+    RunLoop loop;
+    ThreadPool pool({"Test", ThreadType::Worker, ThreadPriority::Regular}, 2);
+
+    std::promise<void> started;
+    bool didWork = false;
+
+    auto request = pool.invokeWithCallback([&] (std::function<void ()> cb) {
+        started.set_value();
+        usleep(10000);
+        didWork = true;
+        cb();
+    }, [&] {});
+
+    started.get_future().get();
+    request.reset();
+    EXPECT_TRUE(didWork);
+}
+
+TEST(ThreadPool, WorkRequestDeletionCancelsAfter) {
+    RunLoop loop;
+    ThreadPool pool({"Test", ThreadType::Worker, ThreadPriority::Regular}, 2);
+
+    std::promise<void> finished;
+    bool didAfter = false;
+
+    auto request = pool.invokeWithCallback([&] (std::function<void ()> cb) {
+        cb();
+        finished.set_value();
+    }, [&] {
+        didAfter = true;
+    });
+
+    finished.get_future().get();
+    request.reset();
+    loop.runOnce();
+    EXPECT_FALSE(didAfter);
+}
+
+TEST(WorkerPool, Shared) {
+    auto pool1 = mbgl::WorkerPool::getShared();
+    auto pool2 = mbgl::WorkerPool::getShared();
+    EXPECT_EQ(pool1, pool2);
+    EXPECT_GE(pool1->getThreadCount(), 1u);
+
+    mbgl::WorkerPool pool3(3);
+    EXPECT_EQ(pool3.getThreadCount(), 3u);
+}